@@ -1,12 +1,25 @@
-#version 330 core
-
-out vec4 FragColor;
-in vec4 vertexColor;
-in vec2 texCoord;
-
-uniform sampler2D tex0;
-uniform sampler2D tex1;
-
-void main() {
-    FragColor = mix(texture(tex0, texCoord), texture(tex1, texCoord), 0.5) /* * vertexColor*/;
+#version 440 core
+
+out vec4 FragColor;
+in vec4 vertexColor;
+in vec2 texCoord;
+flat in uint fragMaterial;
+
+layout (binding = 0) uniform sampler2D tex0;
+layout (binding = 1) uniform sampler2D tex1;
+
+struct Material {
+    vec4 color;
+    float specularStrength;
+    float shininess;
+    float textureMix;
+};
+
+layout (std430, binding = 3) readonly buffer MaterialData {
+    Material materials[];
+};
+
+void main() {
+    Material material = materials[fragMaterial];
+    FragColor = mix(texture(tex0, texCoord), texture(tex1, texCoord), material.textureMix) * material.color /* * vertexColor*/;
 }
\ No newline at end of file
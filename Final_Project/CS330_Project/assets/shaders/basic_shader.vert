@@ -1,18 +1,35 @@
-#version 330 core
-layout (location = 0) in vec3 position;
-layout (location = 1) in vec3 color;
-layout (location = 2) in vec3 normal;
-layout (location = 3) in vec2 uv;
-        
-out vec4 vertexColor;
-out vec2 texCoord;
-
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 model;
-
-void main() {
-    gl_Position = projection * view * model * vec4(position, 1);
-    vertexColor = vec4(color, 1.0f);
-    texCoord = uv;
+#version 440 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 color;
+layout (location = 2) in vec3 normal;
+layout (location = 3) in vec2 uv;
+        
+out vec4 vertexColor;
+out vec2 texCoord;
+flat out uint fragMaterial;
+
+layout (std140, binding = 0) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec3 eyePos;
+};
+
+layout (std140, binding = 1) uniform DrawData {
+    mat4 model;
+    //Quantized meshes store positions relative to their bounds
+    vec4 positionOffset;
+    vec4 positionScale;
+    //Row of the material buffer
+    uint materialIndex;
+};
+
+invariant gl_Position;
+
+void main() {
+    vec3 localPosition = positionOffset.xyz + position * positionScale.xyz;
+
+    gl_Position = projection * view * model * vec4(localPosition, 1);
+    vertexColor = vec4(color, 1.0f);
+    texCoord = uv;
+    fragMaterial = materialIndex;
 }
\ No newline at end of file
@@ -1,11 +1,23 @@
-#version 330 core
-out vec4 FragColor;
-in vec4 vertexColor;
-in vec2 texCoord;
-
-//uniform sampler2D tex0;
-//uniform sampler2D tex1;
-
-void main() {
-    FragColor = vertexColor;
+#version 440 core
+out vec4 FragColor;
+in vec4 vertexColor;
+in vec2 texCoord;
+flat in uint fragMaterial;
+
+//uniform sampler2D tex0;
+//uniform sampler2D tex1;
+
+struct Material {
+    vec4 color;
+    float specularStrength;
+    float shininess;
+    float textureMix;
+};
+
+layout (std430, binding = 3) readonly buffer MaterialData {
+    Material materials[];
+};
+
+void main() {
+    FragColor = vertexColor * materials[fragMaterial].color;
 }
\ No newline at end of file
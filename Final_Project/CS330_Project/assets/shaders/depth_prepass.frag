@@ -0,0 +1,5 @@
+#version 440 core
+
+//Depth only, color writes are off during the pre-pass
+void main() {
+}
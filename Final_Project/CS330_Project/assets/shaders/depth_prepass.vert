@@ -0,0 +1,28 @@
+#version 440 core
+layout (location = 0) in vec3 position;
+
+layout (std140, binding = 0) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec3 eyePos;
+};
+
+layout (std140, binding = 1) uniform DrawData {
+    mat4 model;
+    //Quantized meshes store positions relative to their bounds
+    vec4 positionOffset;
+    vec4 positionScale;
+    //Row of the material buffer
+    uint materialIndex;
+};
+
+//The scene pass tests GL_LEQUAL against this depth, so gl_Position has to come out bit identical.
+//basic_lit.vert, basic_shader.vert and basic_unlit_color.vert compute it with the same expression
+//and declare it invariant too, keep them in step when changing any of them
+invariant gl_Position;
+
+void main() {
+    vec3 localPosition = positionOffset.xyz + position * positionScale.xyz;
+
+    gl_Position = projection * view * model * vec4(localPosition, 1);
+}
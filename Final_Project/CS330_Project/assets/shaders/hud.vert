@@ -0,0 +1,16 @@
+#version 440 core
+//HUD units with y down, as stb_easy_font writes them
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec4 color;
+
+out vec4 vertexColor;
+
+uniform vec2 screenSize;
+uniform float scale;
+
+void main() {
+    vec2 pixel = position.xy * scale;
+
+    gl_Position = vec4(pixel.x / screenSize.x * 2.0 - 1.0, 1.0 - pixel.y / screenSize.y * 2.0, 0, 1);
+    vertexColor = color;
+}
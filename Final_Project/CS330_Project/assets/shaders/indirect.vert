@@ -0,0 +1,43 @@
+#version 440 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 color;
+layout (location = 2) in vec3 normal;
+layout (location = 3) in vec2 uv;
+//Instanced attribute, baseInstance of each indirect draw selects the object
+layout (location = 4) in uint objectIndex;
+
+out vec4 vertexColor;
+out vec3 fragNormal;
+out vec3 fragPosition;
+out vec2 texCoord;
+flat out uint fragMaterial;
+
+layout (std140, binding = 0) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec3 eyePos;
+};
+
+struct ObjectData {
+    mat4 model;
+    vec4 boundsMin;
+    vec4 boundsMax;
+    uint mesh;
+    uint material;
+};
+
+layout (std430, binding = 0) readonly buffer Objects {
+    ObjectData objects[];
+};
+
+void main() {
+    mat4 model = objects[objectIndex].model;
+
+    gl_Position = projection * view * model * vec4(position, 1);
+    fragPosition = vec3(model * vec4(position, 1));
+    vertexColor = vec4(color, 1.0f);
+    fragNormal = mat3(transpose(inverse(model))) * normal;
+
+    texCoord = uv;
+    fragMaterial = objects[objectIndex].material;
+}
\ No newline at end of file
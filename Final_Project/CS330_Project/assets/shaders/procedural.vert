@@ -0,0 +1,123 @@
+#version 440 core
+//No vertex attributes: the shape is rebuilt from gl_VertexID, matching the tables in shapes.h
+
+out vec4 vertexColor;
+out vec3 fragNormal;
+out vec3 fragPosition;
+out vec2 texCoord;
+flat out uint fragMaterial;
+
+layout (std140, binding = 0) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec3 eyePos;
+};
+
+struct Instance {
+    mat4 model;
+    //Cylinder radius and height, unused by the unit plane and cube
+    vec4 size;
+    uint material;
+    uint pad0;
+    uint pad1;
+    uint pad2;
+};
+
+layout (std430, binding = 4) readonly buffer Instances {
+    Instance instances[];
+};
+
+//0 plane, 1 cube, 2 cylinder
+uniform uint shape;
+uniform uint sectors;
+//Start of the draw's instances, GL 4.4 has no gl_BaseInstance
+uniform uint firstInstance;
+
+const float PI = 3.14159265358979;
+
+//Quad corners and the two triangles over them, same order as writeQuad
+const vec2 QUAD_CORNERS[4] = vec2[](vec2(-1, 1), vec2(-1, -1), vec2(1, -1), vec2(1, 1));
+const int QUAD_INDICES[6] = int[](0, 1, 3, 1, 2, 3);
+
+//Center, right and up half axes of each cube face: front, right, back, left, top, bottom
+const vec3 CUBE_FACES[18] = vec3[](
+    vec3(0, 0, 0.5), vec3(0.5, 0, 0), vec3(0, 0.5, 0),
+    vec3(0.5, 0, 0), vec3(0, 0, -0.5), vec3(0, 0.5, 0),
+    vec3(0, 0, -0.5), vec3(-0.5, 0, 0), vec3(0, 0.5, 0),
+    vec3(-0.5, 0, 0), vec3(0, 0, 0.5), vec3(0, 0.5, 0),
+    vec3(0, 0.5, 0), vec3(0.5, 0, 0), vec3(0, 0, -0.5),
+    vec3(0, -0.5, 0), vec3(0.5, 0, 0), vec3(0, 0, 0.5)
+);
+
+void quadVertex(int vertex, vec3 center, vec3 right, vec3 up, out vec3 position, out vec3 normal, out vec2 uv) {
+    vec2 corner = QUAD_CORNERS[QUAD_INDICES[vertex]];
+    position = center + corner.x * right + corner.y * up;
+    normal = normalize(cross(right, up));
+    uv = corner * 0.5 + 0.5;
+}
+
+//Side quads first, then the bottom and top cap fans, like writeCylinder
+void cylinderVertex(int vertex, float radius, float height, out vec3 position, out vec3 normal, out vec2 uv) {
+    int sectorCount = int(sectors);
+    int triangle = vertex / 3;
+    int corner = vertex % 3;
+    float step = 2.0 * PI / float(sectorCount);
+
+    if (triangle < 2 * sectorCount) {
+        int sector = triangle / 2;
+        //(bottom i, bottom i + 1, top i) and (top i, bottom i + 1, top i + 1)
+        const ivec2 SIDE[6] = ivec2[](ivec2(0, 0), ivec2(1, 0), ivec2(0, 1), ivec2(0, 1), ivec2(1, 0), ivec2(1, 1));
+        ivec2 side = SIDE[(triangle % 2) * 3 + corner];
+        int column = sector + side.x;
+        float angle = float(column) * step;
+
+        position = vec3(cos(angle) * radius, sin(angle) * radius, -height / 2.0 + float(side.y) * height);
+        normal = vec3(cos(angle), sin(angle), 0);
+        uv = vec2(float(column) / float(sectorCount), 1.0 - float(side.y));
+        return;
+    }
+
+    int capTriangle = triangle - 2 * sectorCount;
+    int cap = capTriangle / sectorCount;
+    int sector = capTriangle % sectorCount;
+    float z = -height / 2.0 + float(cap) * height;
+    normal = vec3(0, 0, cap == 0 ? -1.0 : 1.0);
+
+    if (corner == 0) {
+        position = vec3(0, 0, z);
+        uv = vec2(0.5);
+        return;
+    }
+
+    //The bottom cap winds (center, next, current), the top one (center, current, next)
+    bool next = (corner == 1) == (cap == 0);
+    float angle = float(next ? sector + 1 : sector) * step;
+    position = vec3(cos(angle) * radius, sin(angle) * radius, z);
+    uv = vec2(-cos(angle) * 0.5 + 0.5, -sin(angle) * 0.5 + 0.5);
+}
+
+void main() {
+    Instance instance = instances[firstInstance + gl_InstanceID];
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+
+    if (shape == 0) {
+        quadVertex(gl_VertexID, vec3(0, -0.5, 0), vec3(-0.5, 0, 0), vec3(0, 0, 0.5), position, normal, uv);
+    }
+    else if (shape == 1) {
+        int face = gl_VertexID / 6;
+        quadVertex(gl_VertexID % 6, CUBE_FACES[face * 3], CUBE_FACES[face * 3 + 1], CUBE_FACES[face * 3 + 2], position, normal, uv);
+    }
+    else {
+        cylinderVertex(gl_VertexID, instance.size.x, instance.size.y, position, normal, uv);
+    }
+
+    gl_Position = projection * view * instance.model * vec4(position, 1);
+    fragPosition = vec3(instance.model * vec4(position, 1));
+    vertexColor = vec4(1.0);
+    fragNormal = mat3(transpose(inverse(instance.model))) * normal;
+
+    texCoord = uv;
+    fragMaterial = instance.material;
+}
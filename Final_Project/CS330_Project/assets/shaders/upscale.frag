@@ -0,0 +1,38 @@
+#version 440 core
+//Stretches the rendered corner of the scene target over the output, bilinear with optional sharpening
+out vec4 FragColor;
+in vec2 texCoord;
+
+layout (binding = 0) uniform sampler2D source;
+//Rendered region in texels, the rest of the target is stale
+uniform vec2 sourceSize;
+//0 for plain bilinear, 1 for the strongest sharpening
+uniform float sharpness;
+
+vec3 sampleSource(vec2 texel) {
+    //Filtering never reaches past the rendered region
+    texel = clamp(texel, vec2(0.5), sourceSize - 0.5);
+    return texture(source, texel / vec2(textureSize(source, 0))).rgb;
+}
+
+void main() {
+    vec2 texel = texCoord * sourceSize;
+    vec3 center = sampleSource(texel);
+
+    if (sharpness <= 0.0) {
+        FragColor = vec4(center, 1.0);
+        return;
+    }
+
+    vec3 left = sampleSource(texel - vec2(1.0, 0.0));
+    vec3 right = sampleSource(texel + vec2(1.0, 0.0));
+    vec3 down = sampleSource(texel - vec2(0.0, 1.0));
+    vec3 up = sampleSource(texel + vec2(0.0, 1.0));
+
+    //Unsharp mask, kept within the neighbourhood's range so edges don't ring
+    vec3 blurred = (left + right + down + up) * 0.25;
+    vec3 low = min(center, min(min(left, right), min(down, up)));
+    vec3 high = max(center, max(max(left, right), max(down, up)));
+
+    FragColor = vec4(clamp(center + (center - blurred) * sharpness * 2.0, low, high), 1.0);
+}
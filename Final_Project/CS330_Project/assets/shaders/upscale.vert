@@ -0,0 +1,10 @@
+#version 440 core
+//One triangle covering the output, no vertex attributes
+out vec2 texCoord;
+
+void main() {
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+
+    texCoord = corner;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -1,56 +1,172 @@
-#pragma once
-
-#include <string>
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-
-#include <mesh.h>
-#include <shader.h>
-#include <camera.h>
-#include <texture.h>
-#include <game_objects/game_object.h>
-
-class Application {
-public:
-	Application(std::string WindowTitle, int width, int height);
-	void Run();
-
-private:
-	bool openWindow();
-	void setupInputs();
-
-	void setUpScene();
-	bool update(float deltaTime);
-	bool draw();
-
-	void handleInput(float deltaTime);
-	void mousePositionCallback(double xpos, double ypos);
-
-private:
-	std::string _applicationName{};
-	int _width{};
-	int _height{};
-	GLFWwindow* _window{ nullptr };
-
-	float _moveSpeed{ .5f };
-	Camera _camera;
-	std::vector<Mesh> _meshes;
-	std::vector<std::unique_ptr<GameObject>> _objects{};
-	std::vector<Texture> _textures;
-	Shader _shader;
-	Shader _basicLitShader;
-	bool _running{ false };
-
-	bool _firstMouse{ false };
-	glm::vec2 _lastMousePosition{-1, -1};
-	glm::vec2 _cameraLookSpeed{};
-
-	float _lastFrameTime{-1.5f};
-
-	GLuint _containerTexture;
-	GLuint _smileTexture;
-
-	//lighting variables
-	float _ambientStrength{ 0.1f };
-	glm::vec3 _ambientLightColor{1.f, 1.f, 1.f};
+#pragma once
+
+#include <array>
+#include <string>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <mesh.h>
+#include <shader.h>
+#include <camera.h>
+#include <texture.h>
+#include <rendering/material.h>
+#include <rendering/occlusion_culler.h>
+#include <rendering/render_thread.h>
+#include <rendering/packet_builder.h>
+#include <core/job_system.h>
+#include <core/scene.h>
+#include <core/prefabs.h>
+#include <core/static_batcher.h>
+#include <core/performance_hud.h>
+#include <core/frame_pacer.h>
+#include <core/input_log.h>
+#include <core/launch_options.h>
+#include <game_objects/game_object.h>
+
+class Application {
+public:
+	Application(std::string WindowTitle, int width, int height, const LaunchOptions& options = {});
+	void Run();
+
+private:
+	bool openWindow();
+	void setupInputs();
+
+	void setUpScene();
+	//--mesh-stats: what welding and reordering did to every mesh of the scene
+	void reportMeshStats() const;
+	bool update(float deltaTime);
+	//One fixed step of everything that animates, true when something moved
+	bool simulate(float step);
+	//On demand mode: blocks in the event loop while the next frame would look like the last one.
+	//True when it waited
+	bool waitWhileIdle();
+	//Fills the next frame snapshot, drawing happens on the render thread
+	bool draw();
+
+	void cullOccludedObjects(const glm::mat4& viewProjection);
+	void gatherGpuScene(GpuSceneUpdate& update);
+	HudStats collectHudStats();
+
+	//Fills _input for this frame from the devices or the replay and records it, returns the frame's step
+	float nextInput(float deltaTime);
+	void handleInput(const InputFrame& input);
+	void handleKeyPress(int key);
+	void mousePositionCallback(double xpos, double ypos);
+
+private:
+	//The scene always advances in steps of this size, whatever the frame rate
+	static constexpr float SimulationStep = 1.f / 60.f;
+	//After a hitch the simulation skips ahead instead of catching up, each step makes the next frame later
+	static constexpr uint32_t MaxStepsPerFrame = 8;
+	//Budget for R when --gpu-budget wasn't given, leaves some room in a 60 fps frame
+	static constexpr float DefaultGpuBudget = 14.f;
+	//Idle wakeups in on demand mode, the HUD refreshes at this rate while nothing else changes
+	static constexpr double IdleTimeout = 0.25;
+
+	struct MoveKey {
+		int Key;
+		Camera::MoveDirection Direction;
+	};
+
+	//Bit i of InputFrame::MoveKeys is held for MoveKeys[i], the order is part of the input log format
+	static constexpr std::array<MoveKey, 6> MoveKeys{ {
+		{ GLFW_KEY_W, Camera::MoveDirection::Forward },
+		{ GLFW_KEY_S, Camera::MoveDirection::Backward },
+		{ GLFW_KEY_A, Camera::MoveDirection::Left },
+		{ GLFW_KEY_D, Camera::MoveDirection::Right },
+		{ GLFW_KEY_Q, Camera::MoveDirection::Up },
+		{ GLFW_KEY_E, Camera::MoveDirection::Down }
+	} };
+	static_assert(MoveKeys.size() <= InputFrame::MaxMoveKeys);
+
+private:
+	std::string _applicationName{};
+	int _width{};
+	int _height{};
+	GLFWwindow* _window{ nullptr };
+
+	float _moveSpeed{ .5f };
+	Camera _camera;
+	std::vector<Mesh> _meshes;
+	std::vector<std::unique_ptr<GameObject>> _objects{};
+	//merged world space meshes of the static objects
+	StaticBatcher _staticBatcher{};
+	std::vector<uint8_t> _batchVisible{};
+
+	//worker threads for update, culling and light assignment; declared before everything that schedules on it
+	JobSystem _jobs{};
+
+	//every material of the game objects, prefabs and static batches; draws reference them by index
+	MaterialLibrary _materials{};
+	uint64_t _sentMaterialVersion{ 0 };
+
+	//component based objects (lights, calculator, peanut jar)
+	Scene _scene{};
+	PrefabLibrary _prefabs{};
+	std::vector<uint32_t> _visibleRenderables{};
+	uint64_t _sentProceduralVersion{ 0 };
+	//frame time not simulated yet, less than a step after update
+	double _unsimulatedTime{ 0 };
+	//on demand mode: set by input and window callbacks, and while the scene animates
+	bool _redrawRequested{ true };
+	bool _animating{ false };
+	std::vector<Texture> _textures;
+	Shader _shader;
+	Shader _basicLitShader;
+	bool _running{ false };
+
+	bool _firstMouse{ false };
+	glm::vec2 _lastMousePosition{-1, -1};
+	glm::vec2 _cameraLookSpeed{};
+
+	float _lastFrameTime{-1.5f};
+
+	GLuint _containerTexture;
+	GLuint _smileTexture;
+
+	//owns the GL context once the scene is set up, destroyed (and joined) before the scene it draws
+	RenderThread _renderThread{};
+	PacketBuilder _packetBuilder{};
+
+	//occlusion culling, toggled with O
+	OcclusionCuller _occlusionCuller{};
+	bool _occlusionCullingEnabled{ true };
+	std::vector<uint8_t> _objectVisible{}; //bytes, written from several jobs
+
+	//scene renderables culled by a compute shader and drawn indirectly, toggled with G
+	bool _gpuDrivenEnabled{ false };
+	bool _gpuSceneSent{ false };
+	uint64_t _gpuLayoutVersion{ 0 };
+
+	//performance overlay, toggled with H
+	PerformanceHud _hud{};
+	double _updateMilliseconds{ 0 };
+	double _drawMilliseconds{ 0 };
+
+	LaunchOptions _launchOptions{};
+	//headless run along a camera path, started with --benchmark
+	Benchmark _benchmark;
+
+	//input of the current frame, the key and scroll callbacks add to it between polls
+	InputFrame _input{};
+	InputRecorder _inputRecorder{};
+	InputPlayer _inputPlayer{};
+
+	//vsync toggled with V, --fps limits the frame rate on top
+	int _swapInterval{ 1 };
+	FramePacer _framePacer{};
+	//dynamic resolution, 0 while off
+	float _gpuBudget{ 0.f };
+	//depth pre-pass of the packets, toggled with Z
+	bool _depthPrepass{ false };
+
+	//screenshot on F12, every frame into _captureDirectory while a sequence runs (F11 or --capture)
+	bool _screenshotRequested{ false };
+	std::filesystem::path _captureDirectory{};
+	uint32_t _capturedFrames{ 0 };
+
+	//lighting variables
+	float _ambientStrength{ 0.1f };
+	glm::vec3 _ambientLightColor{1.f, 1.f, 1.f};
 };
\ No newline at end of file
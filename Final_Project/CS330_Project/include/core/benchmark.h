@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+#include <core/camera.h>
+#include <rendering/stream_buffer.h>
+#include <rendering/types.h>
+
+//Headless run, see LaunchOptions for the command line
+struct BenchmarkOptions {
+	bool Enabled{ false };
+	uint32_t Frames{ 600 };
+	//Rendered before measuring, shader compiles and first uploads stay out of the numbers
+	uint32_t WarmupFrames{ 30 };
+	//Offscreen framebuffer size
+	int Width{ 1280 };
+	int Height{ 720 };
+	//JSON goes to stdout when empty
+	std::filesystem::path Output{};
+};
+
+//Headless performance run: the camera follows a fixed path by frame number, so every run renders the
+//same frames. Collects frame times and render counters and reports them as JSON
+class Benchmark {
+public:
+	//Simulation step of every frame, the scene has to advance the same way on fast and slow machines
+	static constexpr float FrameDelta = 1.f / 60.f;
+
+	explicit Benchmark(const BenchmarkOptions& options);
+
+	bool IsEnabled() const { return _options.Enabled; }
+	const BenchmarkOptions& GetOptions() const { return _options; }
+	bool IsDone() const { return _frame >= _options.WarmupFrames + _options.Frames; }
+
+	//Places the camera for the next frame
+	void UpdateCamera(Camera& camera) const;
+
+	//After each frame was submitted. Render counters belong to the latest frame the render thread finished
+	void AddFrame(double frameMilliseconds, double updateMilliseconds, double drawMilliseconds, const RenderStats& stats);
+
+	//Writes to the output file, or stdout without one. Everything else logs to stderr so stdout parses as JSON
+	bool Report(const StreamBufferStats& streamStats) const;
+
+private:
+	void writeJson(std::ostream& out, const StreamBufferStats& streamStats) const;
+
+private:
+	BenchmarkOptions _options;
+	uint32_t _frame{ 0 };
+
+	std::vector<double> _frameTimes{};
+	std::vector<double> _updateTimes{};
+	std::vector<double> _drawTimes{};
+	std::vector<double> _submitTimes{};
+	std::vector<double> _gpuTimes{};
+
+	//Sums over the measured frames
+	uint64_t _drawCalls{ 0 };
+	uint64_t _triangles{ 0 };
+	uint64_t _programBinds{ 0 };
+	uint64_t _textureBinds{ 0 };
+	double _renderScale{ 0 };
+};
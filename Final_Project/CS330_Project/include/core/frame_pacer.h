@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+//Holds the main loop to a target frame rate. Sleeping alone overshoots by up to a timer tick and
+//spinning alone burns a core, so it sleeps in short slices while there is clearly time left and
+//spins only for the last stretch. How long a slice really takes is measured as it goes
+class FramePacer {
+public:
+	//0 turns the limiter off
+	void SetTargetRate(double framesPerSecond);
+	double GetTargetRate() const { return _targetRate; }
+
+	//Once per frame: returns when the next frame is due
+	void Wait();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	void sleepUntil(Clock::time_point deadline);
+
+private:
+	double _targetRate{ 0. };
+	Clock::duration _period{ 0 };
+	//Start of the current frame's slot, frames are due one period apart from here
+	Clock::time_point _frameStart{};
+
+	//Mean and variance of the measured sleep slices in seconds, starts pessimistic
+	double _sleepMean{ 0.005 };
+	double _sleepVariance{ 0. };
+	uint32_t _sleepSamples{ 1 };
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <glm/glm.hpp>
+
+//Everything the application reacts to in one frame. Live input is polled and collected from the
+//GLFW callbacks into this, replays read it from a log, so both go through the same code
+struct InputFrame {
+	//Bits of the held movement keys, see Application::handleInput
+	static constexpr uint32_t MaxMoveKeys = 8;
+
+	float DeltaTime{ 0.f };
+	uint8_t MoveKeys{ 0 };
+	glm::dvec2 Cursor{};
+	float Scroll{ 0.f };
+	//GLFW key codes pressed since the previous frame, in order
+	std::vector<int16_t> Presses{};
+};
+
+//Appends frames to a binary input log: a short header, then per frame the delta time, scroll,
+//cursor, held keys and the presses. About 30 bytes per frame
+class InputRecorder {
+public:
+	bool Open(const std::filesystem::path& path);
+	bool IsOpen() const { return _out.is_open(); }
+
+	void Write(const InputFrame& frame);
+
+private:
+	std::ofstream _out;
+};
+
+//Reads a whole log up front and hands out its frames in order
+class InputPlayer {
+public:
+	bool Load(const std::filesystem::path& path);
+	bool IsOpen() const { return !_frames.empty(); }
+	bool IsDone() const { return IsOpen() && _nextFrame == _frames.size(); }
+	size_t GetFrameCount() const { return _frames.size(); }
+
+	//False once every frame was played
+	bool Next(InputFrame& frame);
+
+private:
+	std::vector<InputFrame> _frames{};
+	size_t _nextFrame{ 0 };
+};
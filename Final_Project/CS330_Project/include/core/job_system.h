@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Job = std::function<void()>;
+
+//Counts unfinished jobs. Jobs queued with a counter as dependency start once it reaches zero
+class JobCounter {
+public:
+	bool IsDone() const { return _count.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<int32_t> _count{ 0 };
+	std::mutex _mutex;
+	std::vector<Job> _continuations;
+};
+
+//Work stealing job system. Every thread owns a deque: the owner pushes and pops at the back,
+//idle threads steal from the front of the others. The thread that created the system
+//(usually the main thread) owns queue 0 and runs jobs while it waits
+class JobSystem {
+public:
+	//0 uses one thread per hardware thread, the calling thread included
+	explicit JobSystem(uint32_t threadCount = 0);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(_queues.size()); }
+	//In [0, GetThreadCount()), stable for the calling thread; threads outside the system share index 0
+	uint32_t GetThreadIndex() const;
+
+	//counter is incremented now and decremented when the job finished,
+	//dependency delays the job until that counter reaches zero
+	void Run(Job job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+	//Runs queued jobs on the calling thread until the counter reaches zero
+	void Wait(JobCounter& counter);
+
+	//Splits [begin, end) into chunks of at least grainSize items and blocks until all are done
+	void ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const std::function<void(uint32_t first, uint32_t last)>& function);
+
+private:
+	struct WorkQueue {
+		std::mutex Mutex;
+		std::deque<Job> Jobs;
+	};
+
+	void push(Job job);
+	bool tryPop(Job& job);
+	void finish(JobCounter& counter);
+	void workerLoop(uint32_t queueIndex);
+
+private:
+	std::vector<std::unique_ptr<WorkQueue>> _queues;
+	std::vector<std::thread> _workers;
+
+	std::atomic<int32_t> _queuedJobs{ 0 };
+	std::atomic<bool> _stopping{ false };
+	std::mutex _sleepMutex;
+	std::condition_variable _wake;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+
+#include <core/benchmark.h>
+
+//Command line: CS330_Project [--benchmark [--frames N] [--warmup N] [--size WxH] [--output file]]
+//[--record file | --replay file] [--fixed-step] [--capture directory] [--swap-interval N] [--fps N]
+//[--on-demand] [--gpu-budget ms] [--sharpness 0..1] [--depth-prepass] [--mesh-stats]
+struct LaunchOptions {
+	BenchmarkOptions Benchmark{};
+
+	//Input log written while running, or played back instead of live input
+	std::filesystem::path RecordInput{};
+	std::filesystem::path ReplayInput{};
+
+	//Every frame advances by Benchmark::FrameDelta instead of the measured time, also in replays
+	bool FixedStep{ false };
+
+	//Every frame is saved as frame_NNNNN.tga here, for comparing runs image by image
+	std::filesystem::path CaptureDirectory{};
+
+	//Vertical blanks per swap, 0 turns vsync off
+	uint32_t SwapInterval{ 1 };
+	//Frame limiter on top of vsync, 0 for none. Benchmarks always run unlimited
+	uint32_t TargetFrameRate{ 0 };
+
+	//Only draws after input, a resize or while something animates, otherwise sleeps in the event loop.
+	//Ignored by benchmarks and replays, they need every frame
+	bool OnDemand{ false };
+
+	//GPU milliseconds per frame dynamic resolution keeps to, 0 renders at full resolution (R toggles it)
+	float GpuBudgetMilliseconds{ 0.f };
+	float UpscaleSharpness{ 0.25f };
+
+	//Depth of the packets first, then shading only the visible fragments (Z toggles it)
+	bool DepthPrepass{ false };
+
+	//Vertex counts and ACMR of every mesh before and after processing, printed once the scene is loaded
+	bool MeshStats{ false };
+};
+
+//False with a message on unknown or malformed arguments
+bool ParseLaunchOptions(int argc, char* argv[], LaunchOptions& options);
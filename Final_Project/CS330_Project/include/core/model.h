@@ -1,16 +1,18 @@
-#pragma once
-
-#include <rendering/mesh.h>
-#include <rendering/shader.h>
-
-//The model class wraps a mesh and it's shader
-class Model {
-public:
-	Model(std::shared_ptr<Mesh> mesh, std::shared_ptr<Shader> shader);
-	Shader* GetShader() { return _shader.get(); }
-	Mesh* GetMesh() { return _mesh.get(); }
-
-private:
-	std::shared_ptr<Shader> _shader;
-	std::shared_ptr<Mesh> _mesh;
+#pragma once
+
+#include <memory>
+#include <rendering/mesh.h>
+#include <rendering/material.h>
+
+//The model class wraps a mesh and the material it's drawn with
+class Model {
+public:
+	Model(std::shared_ptr<Mesh> mesh, MaterialId material);
+	MaterialId GetMaterial() const { return _material; }
+	Mesh* GetMesh() { return _mesh.get(); }
+	const Mesh* GetMesh() const { return _mesh.get(); }
+
+private:
+	MaterialId _material;
+	std::shared_ptr<Mesh> _mesh;
 };
\ No newline at end of file
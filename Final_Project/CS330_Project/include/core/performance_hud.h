@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <rendering/frame_snapshot.h>
+#include <rendering/types.h>
+
+//Numbers shown on the HUD besides the frame times, collected by the application each frame
+struct HudStats {
+	double UpdateMilliseconds{ 0 };
+	double DrawMilliseconds{ 0 };
+	RenderStats Render{};
+
+	int64_t TextureBytes{ 0 };
+	int64_t BufferBytes{ 0 };
+
+	uint32_t VisibleObjects{ 0 };
+	uint32_t Objects{ 0 };
+	uint32_t VisibleBatches{ 0 };
+	uint32_t Batches{ 0 };
+	uint32_t VisibleRenderables{ 0 };
+	uint32_t Renderables{ 0 };
+	uint32_t Procedurals{ 0 };
+	bool OcclusionCulling{ false };
+	bool GpuCulling{ false };
+	bool DepthPrepass{ false };
+};
+
+//Performance overlay: frame time graph with percentiles, CPU split, draw statistics and memory.
+//Builds stb_easy_font quads on the main thread, the render thread draws them in one call
+class PerformanceHud {
+public:
+	static constexpr uint32_t SampleCount = 200;
+	//Text is laid out again at this interval, readable and most of the build cost saved
+	static constexpr double TextRefreshMilliseconds = 250.0;
+
+	void Toggle() { _visible = !_visible; }
+	bool IsVisible() const { return _visible; }
+
+	//Every frame, also while hidden so the graph is filled when it is shown
+	void AddFrameTime(double milliseconds);
+
+	//Replaces vertices with the overlay, leaves it empty while hidden
+	void Build(const HudStats& stats, std::vector<HudVertex>& vertices);
+
+private:
+	void buildText(const HudStats& stats, float latest, float p50, float p99);
+
+private:
+	std::array<float, SampleCount> _frameTimes{};
+	uint32_t _sampleCount{ 0 };
+	uint32_t _nextSample{ 0 };
+	bool _visible{ false };
+
+	//Text quads and size of the last refresh
+	std::vector<HudVertex> _text{};
+	float _textWidth{ 0.f };
+	float _textHeight{ 0.f };
+	double _sinceTextRefresh{ TextRefreshMilliseconds };
+};
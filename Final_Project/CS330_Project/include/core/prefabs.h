@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <rendering/material.h>
+#include <rendering/shader.h>
+#include <rendering/texture.h>
+#include <core/scene.h>
+
+//Builds the desk objects as components in a Scene.
+//Meshes, shaders, textures and materials are created once in Load and shared by every spawned instance
+class PrefabLibrary {
+public:
+	//Needs a current GL context
+	void Load(MaterialLibrary& materials);
+
+	//Each returns the root entity, moving it moves every part parented under it
+	Entity SpawnCalculator(Scene& scene, const glm::vec3& position, const glm::quat& rotation = glm::quat{ 1.f, 0.f, 0.f, 0.f });
+	Entity SpawnPeanutJar(Scene& scene, const glm::vec3& position, const glm::quat& rotation = glm::quat{ 1.f, 0.f, 0.f, 0.f });
+	Entity SpawnPointLight(Scene& scene, const glm::vec3& position, const PointLightStruct& light);
+
+private:
+	Entity spawnPart(Scene& scene, Entity parent,
+		const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale,
+		const std::shared_ptr<Mesh>& mesh, MaterialId material);
+	//No mesh, the vertex shader builds the shape from the instance parameters
+	Entity spawnProceduralPart(Scene& scene, Entity parent,
+		const glm::vec3& position, const glm::quat& rotation,
+		ProceduralShape shape, uint32_t sectors, const glm::vec2& size, MaterialId material);
+
+private:
+	std::shared_ptr<Shader> _litShader{};
+	std::shared_ptr<Shader> _unlitColorShader{};
+
+	std::shared_ptr<Texture> _plastic1Texture{};
+	std::shared_ptr<Texture> _plastic2Texture{};
+
+	//Calculator body and lights share the cube, jar body and lid the cylinder
+	std::shared_ptr<Mesh> _cubeMesh{};
+	std::shared_ptr<Mesh> _jarMesh{};
+
+	MaterialId _calculatorMaterial{ 0 };
+	MaterialId _jarBodyMaterial{ 0 };
+	MaterialId _jarCoverMaterial{ 0 };
+	MaterialId _lightMaterial{ 0 };
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+//One finished zone. Times are nanoseconds since the profiler started
+struct ProfileEvent {
+	const char* Name{ nullptr };
+	int64_t Start{ 0 };
+	int64_t Duration{ 0 };
+	uint32_t Depth{ 0 };
+};
+
+//Events of one thread (or of the GPU timeline). Only the owner appends, the exporter reads the
+//published prefix, so recording takes no lock
+struct ProfileTrack {
+	static constexpr uint32_t Capacity = 1 << 14;
+
+	std::string Name{};
+	std::unique_ptr<ProfileEvent[]> Events{ std::make_unique<ProfileEvent[]>(Capacity) };
+	std::atomic<uint32_t> Count{ 0 };
+	//Capture the events belong to, the owner clears the track when a new capture started
+	std::atomic<uint64_t> Generation{ 0 };
+	std::atomic<uint32_t> Dropped{ 0 };
+};
+
+//Frame profiler: CPU zones per thread and GPU zones (see GpuProfiler), exported as Chrome trace
+//JSON (chrome://tracing or ui.perfetto.dev). Recording only happens during a capture, outside of
+//one a zone costs a relaxed atomic load
+namespace Profiler {
+	int64_t Now();
+
+	bool IsRecording();
+
+	//Records the next frameCount frames, the trace is written to path once they are done
+	void BeginCapture(uint32_t frameCount, const std::filesystem::path& path);
+	//Main thread, once per frame after the snapshot was submitted
+	void EndFrame();
+
+	//Names the calling thread's track in the trace
+	void SetThreadName(const std::string& name);
+
+	//Extra timelines that aren't threads, e.g. the GPU. Only one thread may record into each
+	ProfileTrack* CreateTrack(const std::string& name);
+
+	void Record(const ProfileEvent& event);
+	void Record(ProfileTrack& track, const ProfileEvent& event);
+
+	bool WriteChromeTrace(const std::filesystem::path& path);
+}
+
+//Records the time between construction and destruction on the calling thread
+class ProfileScope {
+public:
+	explicit ProfileScope(const char* name);
+	~ProfileScope();
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	const char* _name;
+	int64_t _start{ -1 };
+};
+
+//Zones compile to nothing without CS330_PROFILER (set in the project's preprocessor definitions)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef CS330_PROFILER
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__){ name }
+#define PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
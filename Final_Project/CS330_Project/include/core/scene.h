@@ -0,0 +1,258 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <rendering/types.h>
+#include <rendering/frame_snapshot.h>
+#include <rendering/mesh.h>
+#include <rendering/material.h>
+
+class OcclusionCuller;
+class JobSystem;
+
+//Entity handle: low 24 bits are the slot index, high 8 bits the slot generation
+using Entity = uint32_t;
+constexpr Entity NullEntity = std::numeric_limits<Entity>::max();
+
+constexpr uint32_t EntityIndexBits = 24;
+constexpr uint32_t EntityIndexMask = (1u << EntityIndexBits) - 1;
+
+inline uint32_t EntityIndex(Entity entity) { return entity & EntityIndexMask; }
+
+//Maps entities to rows of a densely packed pool.
+//Removing swaps the last row into the hole, so rows stay contiguous
+class SparseSet {
+public:
+	bool Contains(Entity entity) const;
+	uint32_t RowOf(Entity entity) const { return _sparse[EntityIndex(entity)]; }
+
+	size_t Size() const { return _dense.size(); }
+	const std::vector<Entity>& GetEntities() const { return _dense; }
+
+protected:
+	uint32_t insertRow(Entity entity);
+	//Returns the row that was freed, the caller moves the last row of every column into it
+	uint32_t removeRow(Entity entity);
+	//Order preserving removal, rows after the removed one shift down by one
+	uint32_t eraseRow(Entity entity);
+	//Rebuilds the entity order so that row i holds the entity previously at order[i]
+	void reorderRows(const std::vector<uint32_t>& order);
+
+	template <typename... Columns>
+	static void swapPop(uint32_t row, Columns&... columns) {
+		((columns[row] = std::move(columns.back()), columns.pop_back()), ...);
+	}
+
+	template <typename... Columns>
+	static void eraseAt(uint32_t row, Columns&... columns) {
+		(columns.erase(columns.begin() + row), ...);
+	}
+
+	template <typename... Columns>
+	static void permute(const std::vector<uint32_t>& order, Columns&... columns) {
+		auto permuteColumn = [&order](auto& column) {
+			auto source = std::move(column);
+			column.clear();
+			column.reserve(order.size());
+			for (auto row : order) {
+				column.push_back(std::move(source[row]));
+			}
+		};
+		(permuteColumn(columns), ...);
+	}
+
+private:
+	static constexpr uint32_t EmptyRow = std::numeric_limits<uint32_t>::max();
+
+	std::vector<uint32_t> _sparse;
+	std::vector<Entity> _dense;
+};
+
+//Structure of arrays pools, one column per field.
+//Row i of every column belongs to GetEntities()[i]
+//Transform hierarchy kept in topological order: a parent's row always comes before its children,
+//so one forward pass resolves every world matrix. Only dirty rows and their descendants are recomputed
+struct TransformPool : SparseSet {
+	static constexpr uint32_t NoParent = std::numeric_limits<uint32_t>::max();
+
+	//Contiguous rows whose world matrix changed in the last UpdateWorldMatrices
+	struct RowRange {
+		uint32_t First{ 0 };
+		uint32_t Count{ 0 };
+	};
+
+	void Add(Entity entity, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, Entity parent = NullEntity);
+	//Children have to be removed first, see Scene::DestroyEntity
+	void Remove(Entity entity);
+
+	//Reorders rows when the new parent currently sits after the entity
+	void SetParent(Entity entity, Entity parent);
+	void GetDescendants(Entity entity, std::vector<Entity>& descendants) const;
+
+	void SetPosition(Entity entity, const glm::vec3& position);
+	void SetRotation(Entity entity, const glm::quat& rotation);
+	void SetScale(Entity entity, const glm::vec3& scale);
+
+	//Call after writing Positions/Rotations/Scales directly, rows may be marked from several threads
+	void MarkDirty(uint32_t row) {
+		Dirty[row] = 1;
+		_anyDirty.store(true, std::memory_order_relaxed);
+	}
+
+	//Local matrices are built in parallel, the parent to child pass stays in row order
+	void UpdateWorldMatrices(JobSystem& jobs);
+	const std::vector<RowRange>& GetChangedRanges() const { return _changedRanges; }
+
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::quat> Rotations;
+	std::vector<glm::vec3> Scales;
+	std::vector<uint32_t> Parents;
+	std::vector<uint8_t> Dirty;
+	std::vector<glm::mat4> Local;
+	std::vector<glm::mat4> World;
+
+private:
+	std::atomic<bool> _anyDirty{ false };
+	std::vector<uint8_t> _changed;
+	std::vector<RowRange> _changedRanges;
+};
+
+struct RenderablePool : SparseSet {
+	void Add(Entity entity, Mesh* mesh, MaterialId material);
+	void Remove(Entity entity);
+
+	std::vector<Mesh*> Meshes;
+	std::vector<MaterialId> Materials;
+	std::vector<BoundingBox> WorldBounds;
+
+	//Indices into the scene light list, DrawPacket::NoLight marks unused slots
+	std::vector<LightSet> LightSets;
+
+	//Added since the last bounds update
+	std::vector<Entity> PendingBounds;
+
+	//Bumped whenever rows are added or removed, GPU side copies rebuild when it changes
+	uint64_t LayoutVersion{ 0 };
+};
+
+//Primitives drawn by the attribute-less path, no mesh behind them
+struct ProceduralPool : SparseSet {
+	void Add(Entity entity, ProceduralShape shape, uint32_t sectors, const glm::vec2& size, MaterialId material);
+	void Remove(Entity entity);
+
+	std::vector<ProceduralShape> Shapes;
+	std::vector<uint32_t> Sectors;
+	std::vector<glm::vec2> Sizes;
+	std::vector<MaterialId> Materials;
+
+	//Bumped on add, remove and when one of the transforms moved, the instance list is resent when it changes
+	uint64_t Version{ 0 };
+};
+
+struct PointLightPool : SparseSet {
+	void Add(Entity entity, const PointLightStruct& light);
+	void Remove(Entity entity);
+
+	std::vector<glm::vec3> AmbientColors;
+	std::vector<glm::vec3> DiffuseColors;
+	std::vector<glm::vec3> SpecularColors;
+	std::vector<float> Constants;
+	std::vector<float> Linears;
+	std::vector<float> Quadratics;
+};
+
+//Data driven replacement for per object Update overrides
+enum class BehaviourKind : uint8_t {
+	Spin,  // rotate around Axis at Speed radians per second
+	Orbit  // circle Origin on the XZ plane at Radius, Speed radians per second
+};
+
+struct BehaviourPool : SparseSet {
+	void Add(Entity entity, BehaviourKind kind, const glm::vec3& axisOrOrigin, float speed, float radius = 0.f);
+	void Remove(Entity entity);
+
+	std::vector<BehaviourKind> Kinds;
+	std::vector<glm::vec3> Axes;
+	std::vector<glm::vec3> Origins;
+	std::vector<float> Speeds;
+	std::vector<float> Radii;
+	std::vector<float> Elapsed;
+
+	//Simulated poses before and after the last step, the transform shows a blend of the two. Spin
+	//owns the rotation and Orbit the position of its transform, both start from the transform's own
+	std::vector<glm::vec3> PreviousPositions;
+	std::vector<glm::vec3> CurrentPositions;
+	std::vector<glm::quat> PreviousRotations;
+	std::vector<glm::quat> CurrentRotations;
+	std::vector<uint8_t> Started;
+};
+
+//Data oriented scene store. Components live in dense pools and the
+//systems below walk them linearly without virtual calls
+class Scene {
+public:
+	Entity CreateEntity();
+	//Also destroys every child in the transform hierarchy
+	void DestroyEntity(Entity entity);
+	bool IsAlive(Entity entity) const;
+	size_t GetEntityCount() const { return _entityCount; }
+
+	//Advances behaviours by one fixed simulation step
+	void Step(float deltaTime, JobSystem& jobs);
+
+	//Places animated transforms between their previous (0) and last (1) simulated pose, then
+	//refreshes changed world matrices and renderable bounds, all as parallel jobs.
+	//True when a transform moved or a renderable was added, the frame differs from the last one
+	bool Update(float interpolation, JobSystem& jobs);
+
+	//Copies every point light into the frame; the first MAX_POINT_LIGHTS also go to the shared scene parameters
+	void GatherLights(FrameSnapshot& frame);
+
+	//With more lights than the shader takes, picks the strongest ones for the given renderable rows
+	void AssignLights(const std::vector<uint32_t>& rows, JobSystem& jobs);
+	//True when the frame has more lights than the shader takes, draws then carry their own light set
+	bool HasPerPacketLights() const { return _perRenderableLights; }
+	//Strongest MAX_POINT_LIGHTS lights on bounds, for draws that aren't renderables
+	void SelectLights(const BoundingBox& bounds, LightSet& lightSet) const;
+
+	//Collects renderable rows that pass occlusion culling (culler may be null)
+	void GatherVisible(OcclusionCuller* culler, std::vector<uint32_t>& visibleRows, JobSystem& jobs) const;
+
+	//Appends one draw packet per entry of visibleRows[first, last), chunks can be gathered in parallel
+	void GatherDrawPackets(const std::vector<uint32_t>& visibleRows, uint32_t first, uint32_t last, std::vector<DrawPacket>& packets) const;
+
+	//Renderable rows whose world bounds changed in the last Update, in row order
+	const std::vector<uint32_t>& GetChangedRenderables() const { return _changedRenderables; }
+	GpuObjectRecord GetGpuObject(uint32_t row) const;
+
+	void GatherProceduralInstances(std::vector<ProceduralInstance>& instances) const;
+
+public:
+	TransformPool Transforms;
+	RenderablePool Renderables;
+	ProceduralPool Procedurals;
+	PointLightPool PointLights;
+	BehaviourPool Behaviours;
+
+private:
+	void destroySingle(Entity entity);
+	void stepBehaviours(float deltaTime, JobSystem& jobs);
+	void interpolateBehaviours(float interpolation, JobSystem& jobs);
+	void updateRenderableBounds(JobSystem& jobs);
+	void updateProceduralVersion();
+
+private:
+	std::vector<PointLightStruct> _lights;
+	bool _perRenderableLights{ false };
+	std::vector<uint32_t> _changedRenderables;
+
+	std::vector<uint8_t> _generations;
+	std::vector<uint32_t> _freeSlots;
+	size_t _entityCount{ 0 };
+};
@@ -1,501 +1,674 @@
-#pragma once
-
-#include <vector>
-#include <numbers>
-#include <tuple>
-#include <rendering/types.h>
-
-
-struct Shapes {
-    static inline void UpdateNormals(Vertex& p1, Vertex& p2, Vertex& p3) {
-        glm::vec3 U = p2.Position - p1.Position;
-        glm::vec3 V = p3.Position - p1.Position;
-
-        auto normal = glm::cross(U, V);
-
-        p1.Normal = normal;
-        p2.Normal = normal;
-        p3.Normal = normal;
-    };
-
-    static inline std::vector<Vertex> GetUnitCircleVertices(uint32_t sectorCount)
-    {
-        //const float PI = 3.1415926f;
-        float sectorStep = 2.f * std::numbers::pi_v<float> / static_cast<float>(sectorCount);
-        float sectorAngle;  // radian
-
-        std::vector<Vertex> vertices;
-
-        for (auto i = 0; i <= sectorCount; i++)
-        {
-            sectorAngle = static_cast<float>(i) * sectorStep;
-
-            vertices.push_back({
-                .Position = {
-                    std::cos(sectorAngle), // x
-                    std::sin(sectorAngle), // y
-                    0 // z
-                }
-                });
-
-        }
-        return vertices;
-    };
-
-
-    // adapted from: https://www.songho.ca/opengl/gl_cylinder.html
-    static inline std::tuple<std::vector<Vertex>, std::vector<uint32_t>> BuildCylinderSmooth(uint32_t sectorCount, float baseRadius, float height) {
-        std::vector<Vertex> vertices{};
-        std::vector<uint32_t> indices{};
-
-        // get unit circle vectors on XY-plane
-        auto unitCircleVertices = GetUnitCircleVertices(sectorCount);
-
-        /*VERTEX ARRAY*/
-
-        // put side vertices to arrays
-        for (auto i = 0; i < 2; ++i) {
-            float h = -height / 2.f + static_cast<float>(i) * height;           // z value; -h/2 to h/2
-            float t = 1.f - i;                              // vertical tex coord; 1 to 0
-
-            //loop over all unit circle vertices
-            uint32_t vertexIndex{ 0 };
-
-            for (auto vertex : unitCircleVertices) {
-                vertices.push_back({
-                    .Position = {
-                        vertex.Position.x * baseRadius,
-                        vertex.Position.y * baseRadius,
-                        h
-                    },
-                    .Color = {
-                        vertexIndex % 3 == 0.f ? 1.f : 0.f,
-                        vertexIndex % 3 == 0.f ? 1.f : 0.f,
-                        vertexIndex % 3 == 0.f ? 1.f : 0.f,
-                    },
-                    .Normal = {
-                        vertex.Position.x * baseRadius,
-                        vertex.Position.y * baseRadius,
-                        vertex.Position.z * baseRadius,
-                    },
-                    .Uv = {
-                        static_cast<float>(vertexIndex) / static_cast<float>(sectorCount),
-                        t
-                    }
-                });
-
-                vertexIndex++;
-            }
-        }
-
-        auto baseCenterIndex = vertices.size();
-        auto topCenterIndex = baseCenterIndex + sectorCount + 2;
-
-        //Build the top and bottom
-        for (auto i = 0; i < 2; i++) {
-            float h = -height / 2.f + static_cast<float>(i) * height; // z value; -h/2 to h/2
-            float nz = -1.f + static_cast<float>(i) * 2;    // z value of normal; -1 to 1
-
-            //center point
-            vertices.push_back({
-                .Position = {0, 0, h},
-                .Color = {1.f, 1.f, 1.f},
-                .Normal = {0, 0, nz},
-                .Uv = {0.5f, 0.5f}
-            });
-            
-            uint32_t vertexIndex{ 0 };
-            for (auto vertex : unitCircleVertices) {
-                vertices.push_back({
-                        .Position = {
-                            vertex.Position.x * baseRadius,
-                            vertex.Position.y * baseRadius,
-                            h
-                        },
-                        .Color = {
-                            vertexIndex % 3 == 0.f ? 1.f : 0.f,
-                            vertexIndex % 3 == 0.f ? 1.f : 0.f,
-                            vertexIndex % 3 == 0.f ? 1.f : 0.f,
-                        },
-                        .Normal = {
-                            0,
-                            0,
-                            nz,
-                        },
-                        .Uv = {
-                            -vertex.Position.x * 0.5f + 0.5f,
-                            -vertex.Position.x * 0.5f + 0.5f
-                        }
-                    });
-
-                vertexIndex++;
-            }
-        }
-
-        /*ELEMENTS INDEX ARRAY*/
-        uint32_t k1 = 0;
-        uint32_t k2 = sectorCount + 1;
-
-        //side surface
-        for (auto i = 0; i < sectorCount; i++, k1++, k2++) {
-            // 2 triangles per sector
-            indices.push_back(k1);
-            indices.push_back(k1 + 1);
-            indices.push_back(k2);
-
-            indices.push_back(k2);
-            indices.push_back(k1 + 1);
-            indices.push_back(k2 + 1);
-        }
-
-        // bottom surface
-        for (uint32_t i = 0, k = baseCenterIndex; i < sectorCount; i++, k++) {
-            if (i < sectorCount -1) {
-                indices.push_back(baseCenterIndex);
-                indices.push_back(k + 1);
-                indices.push_back(k);
-            }
-            else {
-                indices.push_back(baseCenterIndex);
-                indices.push_back(baseCenterIndex + 1);
-                indices.push_back(k);
-            }
-        }
-
-        // top surface
-        for (uint32_t i = 0, k = topCenterIndex; i < sectorCount; i++, k++) {
-            if (i < sectorCount - 1) {
-                indices.push_back(topCenterIndex);
-                indices.push_back(k);
-                indices.push_back(k + 1);
-            }
-            else {
-                indices.push_back(topCenterIndex);
-                indices.push_back(k);
-                indices.push_back(topCenterIndex + 1);
-            }
-        }
-
-        return { vertices, indices };
-     };
-
-
-    static inline std::vector<Vertex> cubeVertices{
-        // front face - red; facing +z
-         {
-            .Position = {-0.5f, 0.5f, 0.5f}, // 0
-            .Color = {1.f, 0.f, 0.f},
-            //.Normal = {0.f, 0.f, 1.f},
-            .Uv = {0.f, 1.f}
-        },
-        {
-            .Position = {-0.5f, -0.5f, 0.5f}, // 1
-            .Color = {1.f, 0.f, 0.f},
-            //.Normal = {0.f, 0.f, 1.f},
-            .Uv = {0.f, 0.f}
-        },
-        {
-            .Position = {0.5f, -0.5f, 0.5f}, // 2
-            .Color = {1.f, 0.f, 0.f},
-            //.Normal = {0.f, 0.f, 1.f},
-            .Uv = {1.f, 0.f}
-        },
-        {
-            .Position = {0.5f, 0.5f, 0.5f}, // 3
-            .Color = {1.f, 0.f, 0.f},
-            //.Normal = {0.f, 0.f, 1.f},
-            .Uv = {1.f, 1.f}
-        },
-        // right face - green; facing +x
-        {
-            .Position = {0.5f, 0.5f, 0.5f}, // 4
-            .Color = {0.f, 1.f, 0.f},
-            //.Normal = {1.f, 0.f, 0.f},
-            .Uv = {0.f, 1.f}
-        },
-        {
-            .Position = {0.5f, -0.5f, 0.5f}, // 5
-            .Color = {0.f, 1.f, 0.f},
-            //.Normal = {1.f, 0.f, 0.f},
-            .Uv = {0.f, 0.f}
-        },
-        {
-            .Position = {0.5f, -0.5f, -0.5f}, // 6
-            .Color = {0.f, 1.f, 0.f},
-            //.Normal = {1.f, 0.f, 0.f},
-            .Uv = {1.f, 0.f}
-        }
-        ,
-        {
-            .Position = {0.5f, 0.5f, -0.5f}, // 7
-            .Color = {0.f, 1.f, 0.f},
-            //.Normal = {1.f, 0.f, 0.f},
-            .Uv = {1.f, 1.f}
-        },
-        // back face - cyan; facing -z
-        {
-            .Position = {0.5f, 0.5f, -0.5f}, // 8
-            .Color = {0.f, 1.f, 1.f},
-            //.Normal = {0.f, 0.f, -1.f},
-            .Uv = {0.f, 1.f}
-        },
-        {
-            .Position = {0.5f, -0.5f, -0.5f}, // 9
-            .Color = {0.f, 1.f, 1.f},
-            //.Normal = {0.f, 0.f, -1.f},
-            .Uv = {0.f, 0.f}
-        },
-        {
-            .Position = {-0.5f, -0.5f, -0.5f}, // 10
-            .Color = {0.f, 1.f, 1.f},
-            //.Normal = {0.f, 0.f, -1.f},
-            .Uv = {1.f, 0.f}
-        }
-        ,
-        {
-            .Position = {-0.5f, 0.5f, -0.5f}, // 11
-            .Color = {0.f, 1.f, 1.f},
-            //.Normal = {0.f, 0.f, -1.f},
-            .Uv = {1.f, 1.f}
-        },
-        // left face - magenta; facing -x
-        {
-            .Position = {-0.5f, 0.5f, -0.5f}, // 12
-            .Color = {1.f, 0.f, 1.f},
-            //.Normal = {-1.f, 0.f, 0.f},
-            .Uv = {0.f, 1.f}
-        },
-        {
-            .Position = {-0.5f, -0.5f, -0.5f}, // 13
-            .Color = {1.f, 0.f, 1.f},
-            //.Normal = {-1.f, 0.f, 0.f},
-            .Uv = {0.f, 0.f}
-        },
-        {
-            .Position = {-0.5f, -0.5f, 0.5f}, // 14
-            .Color = {1.f, 0.f, 1.f},
-            //.Normal = {-1.f, 0.f, 0.f},
-            .Uv = {1.f, 0.f}
-        }
-        ,
-        {
-            .Position = {-0.5f, 0.5f, 0.5f}, // 15
-            .Color = {1.f, 0.f, 1.f},
-            //.Normal = {-1.f, 0.f, 0.f},
-            .Uv = {1.f, 1.f}
-        },
-        // top face - yellow; facing +y
-        {
-            .Position = {-0.5f, 0.5f, -0.5f}, // 16
-            .Color = {1.f, 1.f, 0.f},
-            //.Normal = {0.f, 1.f, 0.f},
-            .Uv = {0.f, 1.f}
-        },
-        {
-            .Position = {-0.5f, 0.5f, 0.5f}, // 17
-            .Color = {1.f, 1.f, 0.f},
-            //.Normal = {0.f, 1.f, 0.f},
-            .Uv = {0.f, 0.f}
-        },
-        {
-            .Position = {0.5f, 0.5f, 0.5f}, // 18
-            .Color = {1.f, 1.f, 0.f},
-            //.Normal = {0.f, 1.f, 0.f},
-            .Uv = {1.f, 0.f}
-        }
-        ,
-        {
-            .Position = {0.5f, 0.5f, -0.5f}, // 19
-            .Color = {1.f, 1.f, 0.f},
-            //.Normal = {0.f, 1.f, 0.f},
-            .Uv = {1.f, 1.f}
-        },
-        // bottom face - blue; facing -y
-        {
-            .Position = {0.5f, -0.5f, 0.5f}, // 20
-            .Color = {0.0f, 0.0f, 1.0f},
-            //.Normal = {0.f, -1.f, 0.f},
-            .Uv = {0.f, 1.f}
-        },
-        {
-            .Position = {0.5f, -0.5f, -0.5f}, // 21
-            .Color = {0.0f, 0.0f, 1.0f},
-            //.Normal = {0.f, -1.f, 0.f},
-            .Uv = {0.f, 0.f}
-        },
-        {
-            .Position = {-0.5f, -0.5f, -0.5f}, // 22
-            .Color = {0.0f, 0.0f, 1.0f},
-            //.Normal = {0.f, -1.f, 0.f},
-            .Uv = {1.f, 0.f}
-        }
-        ,
-        {
-            .Position = {-0.5f, -0.5f, 0.5f}, // 23
-            .Color = {0.0f, 0.0f, 1.0f},
-            //.Normal = {0.f, -1.f, 0.f},
-            .Uv = {1.f, 1.f}
-        }
-    };
-
-    static inline std::vector<uint32_t> cubeElements{
-        0, 1, 3, // front face
-        1, 2, 3,
-        4, 5, 7, // right face
-        5, 6, 7,
-        8, 9, 11, // back face
-        9, 10, 11,
-        12, 13, 15, // left face
-        13, 14, 15,
-        16, 17, 19, // top face
-        17, 18, 19,
-        20, 21, 23, // bottom face
-        21, 22, 23
-    };
-
-    static inline std::vector<Vertex> planeVertices{
-        // lone face - blue
-       {
-           .Position = {0.5f, -0.5f, 0.5f}, // 0
-           .Color = {0.0f, 0.0f, 1.0f},
-           .Uv = {0.f, 1.f}
-       },
-       {
-           .Position = {0.5f, -0.5f, -0.5f}, // 1
-           .Color = {0.0f, 0.0f, 1.0f},
-           .Uv = {0.f, 0.f}
-       },
-       {
-           .Position = {-0.5f, -0.5f, -0.5f}, // 2
-           .Color = {0.0f, 0.0f, 1.0f},
-           .Uv = {1.f, 0.f}
-       }
-       ,
-       {
-           .Position = {-0.5f, -0.5f, 0.5f}, // 3
-           .Color = {0.0f, 0.0f, 1.0f},
-           .Uv = {1.f, 1.f}
-       }
-    };
-
-    static inline std::vector<uint32_t> planeElements{
-        0, 1, 3, // front face
-        1, 2, 3,
-    };
-
-    static inline std::vector<Vertex> pyramidVertices{
-        // FRONT TRI
-       {
-           .Position = {-0.5f, 0.f, 0.5f}, // 2
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {-1.f, 0.f, 0.f},
-           .Uv = {0.f, 0.f}
-       },
-       {
-           .Position = {0.f, 1.f, 0.0f}, // 1
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {-1.f, 0.f, 0.f},
-           .Uv = {0.5f, 1.f}
-       },
-       {
-           .Position = {0.5f, 0.f, 0.5f}, // 0
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {-1.f, 0.f, 0.f},
-           .Uv = {1.f, 0.f}
-       }
-       ,
-       //RIGHT TRI
-       {
-           .Position = {0.5f, 0.f, 0.5f}, // 5
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, 0.f, 1.f},
-           .Uv = {0.f, 0.f}
-       },
-       {
-           .Position = {0.f, 1.f, 0.f}, // 4
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, 0.f, 1.f},
-           .Uv = {0.5f, 1.f}
-       },
-       {
-           .Position = {0.5f, 0.f, -0.5f}, // 3
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, 0.f, 1.f},
-           .Uv = {1.f, 0.f}
-       },
-        //BACK TRI
-        {
-            .Position = {0.5f, 0.f, -0.5f}, // 8
-            .Color = {0.0f, 0.0f, 1.0f},
-            //.Normal = {0.f, 0.f, 1.f},
-            .Uv = {0.f, 0.f}
-        },
-        {
-            .Position = {0.f, 1.f, 0.f}, // 7
-            .Color = {0.0f, 0.0f, 1.0f},
-            //.Normal = {0.f, 0.f, 1.f},
-            .Uv = {0.5f, 1.f}
-        },
-        {
-            .Position = {-0.5f, 0.f, -0.5f}, // 6
-            .Color = {0.0f, 0.0f, 1.0f},
-            //.Normal = {0.f, 0.f, 1.f},
-            .Uv = {1.f, 0.f}
-        },
-        //LEFT TRI
-       {
-           .Position = {-0.5f, 0.f, -0.5f}, // 11
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, 0.f, 1.f},
-           .Uv = {0.f, 0.f}
-       },
-       {
-           .Position = {0.f, 1.f, 0.f}, // 10
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, 0.f, 1.f},
-           .Uv = {0.5f, 1.f}
-       },
-       {
-           .Position = {-0.5f, 0.f, 0.5f}, // 9
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, 0.f, 1.f},
-           .Uv = {1.f, 0.f}
-       },
-
-        //BOTTOM QUAD
-       {
-           .Position = {-0.5f, 0.f, -0.5f}, // 14
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, -1.f, 0.f},
-           .Uv = {0.f, 0.f}
-       },
-       {
-           .Position = {-0.5f, 0.f, 0.5f}, // 13
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, -1.f, 0.f},
-           .Uv = {0.f, 1.f}
-       },
-       {
-           .Position = {0.5f, 0.f, -0.5f}, // 12
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, -1.f, 0.f},
-           .Uv = {1.f, 0.f}
-       },
-       {
-           .Position = {0.5f, 0.f, 0.5f}, // 15
-           .Color = {0.0f, 0.0f, 1.0f},
-           //.Normal = {0.f, -1.f, 0.f},
-           .Uv = {1.f, 1.f}
-       }
-    };
-
-    static inline std::vector<uint32_t> pyramidElements{
-        2, 1, 0, // front tri face
-        5, 4, 3, // right tri face
-        8, 7, 6, // back tri face
-        11, 10, 9, // left tri face
-        14, 13, 12, // bottom quad faces
-        14, 15, 13
-    };
-
-};
\ No newline at end of file
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <rendering/types.h>
+
+//Procedural primitives. Every generator is constexpr and templated on its tessellation, so
+//Shapes::Cylinder<32>(0.25f, 0.75f) in a constexpr variable is built by the compiler and ends up in
+//read only data. The Build* functions run the same generators at runtime for tessellations that are
+//only known then. Round primitives are built around the Z axis, faces wind counter clockwise
+namespace Shapes {
+    template <size_t VertexCount, size_t ElementCount>
+    struct StaticMeshData {
+        std::array<Vertex, VertexCount> Vertices{};
+        std::array<uint32_t, ElementCount> Elements{};
+    };
+
+    struct MeshData {
+        std::vector<Vertex> Vertices;
+        std::vector<uint32_t> Elements;
+    };
+
+    namespace detail {
+        constexpr double Pi = std::numbers::pi;
+
+        //std::sin and friends are not constexpr in C++20: series while constant evaluating, the library at runtime
+        constexpr double sinSeries(double x) {
+            //Wrap to [-pi, pi] where 12 terms are exact to double precision
+            auto turns = x / (2.0 * Pi);
+            auto whole = static_cast<double>(static_cast<long long>(turns >= 0.0 ? turns + 0.5 : turns - 0.5));
+            x -= whole * 2.0 * Pi;
+
+            auto term = x;
+            auto sum = x;
+            for (auto i = 1; i < 12; i++) {
+                term *= -x * x / ((2.0 * i) * (2.0 * i + 1.0));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr double sqrtNewton(double x) {
+            if (x <= 0.0) {
+                return 0.0;
+            }
+            auto guess = x > 1.0 ? x : 1.0;
+            for (auto i = 0; i < 64; i++) {
+                auto next = 0.5 * (guess + x / guess);
+                if (next == guess) {
+                    break;
+                }
+                guess = next;
+            }
+            return guess;
+        }
+
+        //atan on [-1, 1]: two argument halvings, then the series converges quickly
+        constexpr double atanSeries(double x) {
+            for (auto i = 0; i < 2; i++) {
+                x = x / (1.0 + sqrtNewton(1.0 + x * x));
+            }
+
+            auto term = x;
+            auto sum = x;
+            for (auto i = 1; i < 16; i++) {
+                term *= -x * x;
+                sum += term / (2.0 * i + 1.0);
+            }
+            return sum * 4.0;
+        }
+
+        constexpr float Abs(float x) {
+            return x < 0.f ? -x : x;
+        }
+
+        constexpr float Sin(float x) {
+            if (std::is_constant_evaluated()) {
+                return static_cast<float>(sinSeries(x));
+            }
+            return std::sin(x);
+        }
+
+        constexpr float Cos(float x) {
+            if (std::is_constant_evaluated()) {
+                return static_cast<float>(sinSeries(x + Pi / 2.0));
+            }
+            return std::cos(x);
+        }
+
+        constexpr float Sqrt(float x) {
+            if (std::is_constant_evaluated()) {
+                return static_cast<float>(sqrtNewton(x));
+            }
+            return std::sqrt(x);
+        }
+
+        constexpr float Atan2(float y, float x) {
+            if (std::is_constant_evaluated()) {
+                if (x == 0.f && y == 0.f) {
+                    return 0.f;
+                }
+                //Fold into |ratio| <= 1, then back to the right octant
+                if (Abs(x) >= Abs(y)) {
+                    auto angle = atanSeries(static_cast<double>(y) / x);
+                    return static_cast<float>(x > 0.f ? angle : (y >= 0.f ? angle + Pi : angle - Pi));
+                }
+                auto angle = atanSeries(static_cast<double>(x) / y);
+                return static_cast<float>(y > 0.f ? Pi / 2.0 - angle : -Pi / 2.0 - angle);
+            }
+            return std::atan2(y, x);
+        }
+
+        constexpr glm::vec3 Normalize(const glm::vec3& v) {
+            auto length = Sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+            return length > 0.f ? v / length : v;
+        }
+
+        constexpr glm::vec3 Cross(const glm::vec3& a, const glm::vec3& b) {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        //Spherical mapping of a unit direction around Z
+        constexpr glm::vec2 SphereUv(const glm::vec3& normal) {
+            auto u = Atan2(normal.y, normal.x) / (2.f * std::numbers::pi_v<float>) + 0.5f;
+            auto v = Atan2(normal.z, Sqrt(normal.x * normal.x + normal.y * normal.y)) / std::numbers::pi_v<float> + 0.5f;
+            return { u, v };
+        }
+
+        //Generators write through one of these, fixed arrays at compile time or vectors at runtime
+        template <size_t VertexCount, size_t ElementCount>
+        struct FixedWriter {
+            StaticMeshData<VertexCount, ElementCount> Data{};
+            uint32_t VertexIndex{ 0 };
+            uint32_t ElementIndex{ 0 };
+
+            constexpr void Reserve(size_t, size_t) {}
+
+            constexpr uint32_t AddVertex(const Vertex& vertex) {
+                Data.Vertices[VertexIndex] = vertex;
+                return VertexIndex++;
+            }
+
+            constexpr void AddTriangle(uint32_t a, uint32_t b, uint32_t c) {
+                Data.Elements[ElementIndex++] = a;
+                Data.Elements[ElementIndex++] = b;
+                Data.Elements[ElementIndex++] = c;
+            }
+        };
+
+        struct DynamicWriter {
+            MeshData Data{};
+
+            void Reserve(size_t vertexCount, size_t elementCount) {
+                Data.Vertices.reserve(vertexCount);
+                Data.Elements.reserve(elementCount);
+            }
+
+            uint32_t AddVertex(const Vertex& vertex) {
+                Data.Vertices.push_back(vertex);
+                return static_cast<uint32_t>(Data.Vertices.size() - 1);
+            }
+
+            void AddTriangle(uint32_t a, uint32_t b, uint32_t c) {
+                Data.Elements.insert(Data.Elements.end(), { a, b, c });
+            }
+        };
+
+        //Vertex and element counts, also the array sizes of the compile time versions
+        struct Counts {
+            size_t Vertices;
+            size_t Elements;
+        };
+
+        constexpr Counts cubeCounts() { return { 24, 36 }; }
+        constexpr Counts planeCounts() { return { 4, 6 }; }
+        constexpr Counts pyramidCounts() { return { 16, 18 }; }
+        constexpr Counts cylinderCounts(uint32_t sectors) { return { 4 * sectors + 4, 12 * sectors }; }
+        constexpr Counts coneCounts(uint32_t sectors) { return { 3 * sectors + 2, 6 * sectors }; }
+        constexpr Counts uvSphereCounts(uint32_t sectors, uint32_t stacks) { return { (stacks + 1) * (sectors + 1), 6 * sectors * (stacks - 1) }; }
+        constexpr Counts icosphereCounts(uint32_t subdivisions) { return { 10 * (1u << (2 * subdivisions)) + 2, 60 * (1u << (2 * subdivisions)) }; }
+        constexpr Counts torusCounts(uint32_t sectors, uint32_t sides) { return { (sectors + 1) * (sides + 1), 6 * sectors * sides }; }
+        constexpr Counts capsuleCounts(uint32_t sectors, uint32_t stacks) { return { (2 * stacks + 2) * (sectors + 1), 12 * sectors * stacks }; }
+
+        //Quad from its center and half axes, normal is right x up. Corner order and UVs as the old hand written tables
+        template <typename Writer>
+        constexpr void writeQuad(Writer& writer, const glm::vec3& center, const glm::vec3& right, const glm::vec3& up) {
+            auto normal = Normalize(Cross(right, up));
+            auto first = writer.AddVertex({ .Position = center - right + up, .Normal = normal, .Uv = { 0.f, 1.f } });
+            writer.AddVertex({ .Position = center - right - up, .Normal = normal, .Uv = { 0.f, 0.f } });
+            writer.AddVertex({ .Position = center + right - up, .Normal = normal, .Uv = { 1.f, 0.f } });
+            writer.AddVertex({ .Position = center + right + up, .Normal = normal, .Uv = { 1.f, 1.f } });
+
+            writer.AddTriangle(first, first + 1, first + 3);
+            writer.AddTriangle(first + 1, first + 2, first + 3);
+        }
+
+        //Unit cube centered on the origin
+        template <typename Writer>
+        constexpr void writeCube(Writer& writer) {
+            writeQuad(writer, { 0.f, 0.f, 0.5f }, { 0.5f, 0.f, 0.f }, { 0.f, 0.5f, 0.f });   // front, +z
+            writeQuad(writer, { 0.5f, 0.f, 0.f }, { 0.f, 0.f, -0.5f }, { 0.f, 0.5f, 0.f });  // right, +x
+            writeQuad(writer, { 0.f, 0.f, -0.5f }, { -0.5f, 0.f, 0.f }, { 0.f, 0.5f, 0.f }); // back, -z
+            writeQuad(writer, { -0.5f, 0.f, 0.f }, { 0.f, 0.f, 0.5f }, { 0.f, 0.5f, 0.f });  // left, -x
+            writeQuad(writer, { 0.f, 0.5f, 0.f }, { 0.5f, 0.f, 0.f }, { 0.f, 0.f, -0.5f });  // top, +y
+            writeQuad(writer, { 0.f, -0.5f, 0.f }, { 0.5f, 0.f, 0.f }, { 0.f, 0.f, 0.5f });  // bottom, -y
+        }
+
+        //Unit square facing +y, at the height of the cube's bottom face
+        template <typename Writer>
+        constexpr void writePlane(Writer& writer) {
+            writeQuad(writer, { 0.f, -0.5f, 0.f }, { -0.5f, 0.f, 0.f }, { 0.f, 0.f, 0.5f });
+        }
+
+        //Square base on y = 0, apex at y = 1
+        template <typename Writer>
+        constexpr void writePyramid(Writer& writer) {
+            constexpr glm::vec3 apex{ 0.f, 1.f, 0.f };
+            constexpr std::array<glm::vec3, 4> base{ {
+                { -0.5f, 0.f, 0.5f }, { 0.5f, 0.f, 0.5f }, { 0.5f, 0.f, -0.5f }, { -0.5f, 0.f, -0.5f }
+            } };
+
+            for (auto i = 0; i < 4; i++) {
+                const auto& left = base[i];
+                const auto& right = base[(i + 1) % 4];
+                auto normal = Normalize(Cross(right - left, apex - left));
+
+                auto first = writer.AddVertex({ .Position = left, .Normal = normal, .Uv = { 0.f, 0.f } });
+                writer.AddVertex({ .Position = apex, .Normal = normal, .Uv = { 0.5f, 1.f } });
+                writer.AddVertex({ .Position = right, .Normal = normal, .Uv = { 1.f, 0.f } });
+                writer.AddTriangle(first + 2, first + 1, first);
+            }
+
+            writeQuad(writer, { 0.f, 0.f, 0.f }, { 0.5f, 0.f, 0.f }, { 0.f, 0.f, 0.5f });
+        }
+
+        //Side rings carry a duplicate seam vertex for the wrapping UVs, caps are fans
+        template <typename Writer>
+        constexpr void writeCylinder(Writer& writer, uint32_t sectors, float radius, float height) {
+            auto counts = cylinderCounts(sectors);
+            writer.Reserve(counts.Vertices, counts.Elements);
+
+            auto sectorStep = 2.f * std::numbers::pi_v<float> / static_cast<float>(sectors);
+
+            for (auto ring = 0; ring < 2; ring++) {
+                auto z = -height / 2.f + static_cast<float>(ring) * height;
+                for (uint32_t i = 0; i <= sectors; i++) {
+                    auto angle = static_cast<float>(i) * sectorStep;
+                    auto x = Cos(angle);
+                    auto y = Sin(angle);
+                    writer.AddVertex({
+                        .Position = { x * radius, y * radius, z },
+                        .Normal = { x, y, 0.f },
+                        .Uv = { static_cast<float>(i) / static_cast<float>(sectors), 1.f - static_cast<float>(ring) }
+                    });
+                }
+            }
+
+            for (uint32_t i = 0; i < sectors; i++) {
+                auto bottom = i;
+                auto top = i + sectors + 1;
+                writer.AddTriangle(bottom, bottom + 1, top);
+                writer.AddTriangle(top, bottom + 1, top + 1);
+            }
+
+            for (auto cap = 0; cap < 2; cap++) {
+                auto z = -height / 2.f + static_cast<float>(cap) * height;
+                auto normalZ = cap == 0 ? -1.f : 1.f;
+                auto center = writer.AddVertex({ .Position = { 0.f, 0.f, z }, .Normal = { 0.f, 0.f, normalZ }, .Uv = { 0.5f, 0.5f } });
+
+                for (uint32_t i = 0; i < sectors; i++) {
+                    auto angle = static_cast<float>(i) * sectorStep;
+                    auto x = Cos(angle);
+                    auto y = Sin(angle);
+                    writer.AddVertex({
+                        .Position = { x * radius, y * radius, z },
+                        .Normal = { 0.f, 0.f, normalZ },
+                        .Uv = { -x * 0.5f + 0.5f, -y * 0.5f + 0.5f }
+                    });
+                }
+
+                for (uint32_t i = 0; i < sectors; i++) {
+                    auto current = center + 1 + i;
+                    auto next = center + 1 + (i + 1) % sectors;
+                    if (cap == 0) {
+                        writer.AddTriangle(center, next, current);
+                    }
+                    else {
+                        writer.AddTriangle(center, current, next);
+                    }
+                }
+            }
+        }
+
+        //Base on z = -height / 2, apex on z = height / 2. One apex vertex per sector keeps the side normals smooth
+        template <typename Writer>
+        constexpr void writeCone(Writer& writer, uint32_t sectors, float radius, float height) {
+            auto counts = coneCounts(sectors);
+            writer.Reserve(counts.Vertices, counts.Elements);
+
+            auto sectorStep = 2.f * std::numbers::pi_v<float> / static_cast<float>(sectors);
+            auto slope = Normalize({ height, 0.f, radius });
+
+            for (uint32_t i = 0; i <= sectors; i++) {
+                auto angle = static_cast<float>(i) * sectorStep;
+                auto x = Cos(angle);
+                auto y = Sin(angle);
+                writer.AddVertex({
+                    .Position = { x * radius, y * radius, -height / 2.f },
+                    .Normal = { x * slope.x, y * slope.x, slope.z },
+                    .Uv = { static_cast<float>(i) / static_cast<float>(sectors), 0.f }
+                });
+            }
+
+            for (uint32_t i = 0; i < sectors; i++) {
+                auto angle = (static_cast<float>(i) + 0.5f) * sectorStep;
+                auto apex = writer.AddVertex({
+                    .Position = { 0.f, 0.f, height / 2.f },
+                    .Normal = { Cos(angle) * slope.x, Sin(angle) * slope.x, slope.z },
+                    .Uv = { (static_cast<float>(i) + 0.5f) / static_cast<float>(sectors), 1.f }
+                });
+                writer.AddTriangle(i, i + 1, apex);
+            }
+
+            auto center = writer.AddVertex({ .Position = { 0.f, 0.f, -height / 2.f }, .Normal = { 0.f, 0.f, -1.f }, .Uv = { 0.5f, 0.5f } });
+            for (uint32_t i = 0; i < sectors; i++) {
+                auto angle = static_cast<float>(i) * sectorStep;
+                auto x = Cos(angle);
+                auto y = Sin(angle);
+                writer.AddVertex({
+                    .Position = { x * radius, y * radius, -height / 2.f },
+                    .Normal = { 0.f, 0.f, -1.f },
+                    .Uv = { -x * 0.5f + 0.5f, -y * 0.5f + 0.5f }
+                });
+            }
+
+            for (uint32_t i = 0; i < sectors; i++) {
+                writer.AddTriangle(center, center + 1 + (i + 1) % sectors, center + 1 + i);
+            }
+        }
+
+        //Rings of latitude from the +z pole down, the pole rows only get one triangle per sector
+        template <typename Writer>
+        constexpr void writeUvSphere(Writer& writer, uint32_t sectors, uint32_t stacks, float radius) {
+            auto counts = uvSphereCounts(sectors, stacks);
+            writer.Reserve(counts.Vertices, counts.Elements);
+
+            auto sectorStep = 2.f * std::numbers::pi_v<float> / static_cast<float>(sectors);
+            auto stackStep = std::numbers::pi_v<float> / static_cast<float>(stacks);
+
+            for (uint32_t stack = 0; stack <= stacks; stack++) {
+                auto latitude = std::numbers::pi_v<float> / 2.f - static_cast<float>(stack) * stackStep;
+                auto ringRadius = Cos(latitude);
+                auto z = Sin(latitude);
+
+                for (uint32_t i = 0; i <= sectors; i++) {
+                    auto angle = static_cast<float>(i) * sectorStep;
+                    glm::vec3 normal{ ringRadius * Cos(angle), ringRadius * Sin(angle), z };
+                    writer.AddVertex({
+                        .Position = normal * radius,
+                        .Normal = normal,
+                        .Uv = { static_cast<float>(i) / static_cast<float>(sectors), 1.f - static_cast<float>(stack) / static_cast<float>(stacks) }
+                    });
+                }
+            }
+
+            for (uint32_t stack = 0; stack < stacks; stack++) {
+                for (uint32_t i = 0; i < sectors; i++) {
+                    auto upper = stack * (sectors + 1) + i;
+                    auto lower = upper + sectors + 1;
+
+                    if (stack != 0) {
+                        writer.AddTriangle(upper, lower, upper + 1);
+                    }
+                    if (stack != stacks - 1) {
+                        writer.AddTriangle(upper + 1, lower, lower + 1);
+                    }
+                }
+            }
+        }
+
+        //Geodesic sphere: every icosahedron face is split into a grid of n x n triangles (n = 2^subdivisions)
+        //and projected onto the sphere. Grid points get ids without a lookup table: the 12 corners,
+        //then n - 1 points on each of the 30 edges, then the face interiors
+        constexpr std::array<glm::vec3, 12> IcosahedronVertices{ {
+            { -0.525731f, 0.850651f, 0.f }, { 0.525731f, 0.850651f, 0.f }, { -0.525731f, -0.850651f, 0.f }, { 0.525731f, -0.850651f, 0.f },
+            { 0.f, -0.525731f, 0.850651f }, { 0.f, 0.525731f, 0.850651f }, { 0.f, -0.525731f, -0.850651f }, { 0.f, 0.525731f, -0.850651f },
+            { 0.850651f, 0.f, -0.525731f }, { 0.850651f, 0.f, 0.525731f }, { -0.850651f, 0.f, -0.525731f }, { -0.850651f, 0.f, 0.525731f }
+        } };
+
+        constexpr std::array<std::array<uint32_t, 3>, 20> IcosahedronFaces{ {
+            { 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+            { 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+            { 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+            { 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 }
+        } };
+
+        //The 30 edges as (lower, higher) corner pairs, in order of first appearance
+        constexpr std::array<std::array<uint32_t, 2>, 30> icosahedronEdges() {
+            std::array<std::array<uint32_t, 2>, 30> edges{};
+            uint32_t count = 0;
+            for (const auto& face : IcosahedronFaces) {
+                for (auto k = 0; k < 3; k++) {
+                    auto a = std::min(face[k], face[(k + 1) % 3]);
+                    auto b = std::max(face[k], face[(k + 1) % 3]);
+                    auto known = false;
+                    for (uint32_t e = 0; e < count; e++) {
+                        known = known || (edges[e][0] == a && edges[e][1] == b);
+                    }
+                    if (!known) {
+                        edges[count++] = { a, b };
+                    }
+                }
+            }
+            return edges;
+        }
+
+        constexpr auto IcosahedronEdges = icosahedronEdges();
+
+        //Id of the point step steps from corner a towards corner b, 0 < step < n
+        constexpr uint32_t icosphereEdgePoint(uint32_t a, uint32_t b, uint32_t step, uint32_t n) {
+            for (uint32_t e = 0; e < IcosahedronEdges.size(); e++) {
+                if (IcosahedronEdges[e][0] == a && IcosahedronEdges[e][1] == b) {
+                    return 12 + e * (n - 1) + step - 1;
+                }
+                if (IcosahedronEdges[e][0] == b && IcosahedronEdges[e][1] == a) {
+                    return 12 + e * (n - 1) + (n - step) - 1;
+                }
+            }
+            return 0;
+        }
+
+        //Grid point (i, j) of a face: corner0 + i/n (corner1 - corner0) + j/n (corner2 - corner0)
+        constexpr uint32_t icospherePoint(uint32_t face, uint32_t i, uint32_t j, uint32_t n) {
+            const auto& corners = IcosahedronFaces[face];
+            if (i == 0 && j == 0) return corners[0];
+            if (i == n) return corners[1];
+            if (j == n) return corners[2];
+            if (j == 0) return icosphereEdgePoint(corners[0], corners[1], i, n);
+            if (i == 0) return icosphereEdgePoint(corners[0], corners[2], j, n);
+            if (i + j == n) return icosphereEdgePoint(corners[1], corners[2], j, n);
+
+            //Interior points, row by row
+            auto interiorPerFace = (n - 1) * (n - 2) / 2;
+            auto row = j - 1;
+            auto rowStart = row * (n - 2) - row * (row - 1) / 2;
+            return 12 + 30 * (n - 1) + face * interiorPerFace + rowStart + (i - 1);
+        }
+
+        template <typename Writer>
+        constexpr void writeIcosphere(Writer& writer, uint32_t subdivisions, float radius) {
+            auto counts = icosphereCounts(subdivisions);
+            writer.Reserve(counts.Vertices, counts.Elements);
+
+            auto n = 1u << subdivisions;
+            auto addPoint = [&writer, radius](const glm::vec3& point) {
+                auto normal = Normalize(point);
+                writer.AddVertex({ .Position = normal * radius, .Normal = normal, .Uv = SphereUv(normal) });
+            };
+
+            //Same order as the ids handed out by icospherePoint
+            for (const auto& corner : IcosahedronVertices) {
+                addPoint(corner);
+            }
+
+            for (const auto& edge : IcosahedronEdges) {
+                const auto& a = IcosahedronVertices[edge[0]];
+                const auto& b = IcosahedronVertices[edge[1]];
+                for (uint32_t step = 1; step < n; step++) {
+                    addPoint(a + (b - a) * (static_cast<float>(step) / static_cast<float>(n)));
+                }
+            }
+
+            for (const auto& face : IcosahedronFaces) {
+                const auto& corner0 = IcosahedronVertices[face[0]];
+                auto along1 = (IcosahedronVertices[face[1]] - corner0) / static_cast<float>(n);
+                auto along2 = (IcosahedronVertices[face[2]] - corner0) / static_cast<float>(n);
+
+                for (uint32_t j = 1; j + 1 < n; j++) {
+                    for (uint32_t i = 1; i + j < n; i++) {
+                        addPoint(corner0 + along1 * static_cast<float>(i) + along2 * static_cast<float>(j));
+                    }
+                }
+            }
+
+            for (uint32_t face = 0; face < IcosahedronFaces.size(); face++) {
+                for (uint32_t j = 0; j < n; j++) {
+                    for (uint32_t i = 0; i + j < n; i++) {
+                        writer.AddTriangle(icospherePoint(face, i, j, n), icospherePoint(face, i + 1, j, n), icospherePoint(face, i, j + 1, n));
+                        if (i + j + 1 < n) {
+                            writer.AddTriangle(icospherePoint(face, i + 1, j, n), icospherePoint(face, i + 1, j + 1, n), icospherePoint(face, i, j + 1, n));
+                        }
+                    }
+                }
+            }
+        }
+
+        //Tube of minorRadius swept around Z at majorRadius
+        template <typename Writer>
+        constexpr void writeTorus(Writer& writer, uint32_t sectors, uint32_t sides, float majorRadius, float minorRadius) {
+            auto counts = torusCounts(sectors, sides);
+            writer.Reserve(counts.Vertices, counts.Elements);
+
+            auto sectorStep = 2.f * std::numbers::pi_v<float> / static_cast<float>(sectors);
+            auto sideStep = 2.f * std::numbers::pi_v<float> / static_cast<float>(sides);
+
+            for (uint32_t i = 0; i <= sectors; i++) {
+                auto sectorX = Cos(static_cast<float>(i) * sectorStep);
+                auto sectorY = Sin(static_cast<float>(i) * sectorStep);
+
+                for (uint32_t j = 0; j <= sides; j++) {
+                    auto sideCos = Cos(static_cast<float>(j) * sideStep);
+                    auto sideSin = Sin(static_cast<float>(j) * sideStep);
+                    auto distance = majorRadius + minorRadius * sideCos;
+
+                    writer.AddVertex({
+                        .Position = { distance * sectorX, distance * sectorY, minorRadius * sideSin },
+                        .Normal = { sideCos * sectorX, sideCos * sectorY, sideSin },
+                        .Uv = { static_cast<float>(i) / static_cast<float>(sectors), static_cast<float>(j) / static_cast<float>(sides) }
+                    });
+                }
+            }
+
+            for (uint32_t i = 0; i < sectors; i++) {
+                for (uint32_t j = 0; j < sides; j++) {
+                    auto current = i * (sides + 1) + j;
+                    auto next = current + sides + 1;
+                    writer.AddTriangle(current, next, current + 1);
+                    writer.AddTriangle(current + 1, next, next + 1);
+                }
+            }
+        }
+
+        //Cylinder of the given height with hemisphere caps, stacks rings per hemisphere. Total length is height + 2 * radius
+        template <typename Writer>
+        constexpr void writeCapsule(Writer& writer, uint32_t sectors, uint32_t stacks, float radius, float height) {
+            auto counts = capsuleCounts(sectors, stacks);
+            writer.Reserve(counts.Vertices, counts.Elements);
+
+            auto sectorStep = 2.f * std::numbers::pi_v<float> / static_cast<float>(sectors);
+            auto stackStep = std::numbers::pi_v<float> / 2.f / static_cast<float>(stacks);
+            auto rings = 2 * stacks + 2;
+            auto totalLength = height + 2.f * radius;
+
+            //Rings 0..stacks are the top hemisphere down to its equator, the rest the bottom one
+            for (uint32_t ring = 0; ring < rings; ring++) {
+                auto top = ring <= stacks;
+                auto latitude = top ? std::numbers::pi_v<float> / 2.f - static_cast<float>(ring) * stackStep : -static_cast<float>(ring - stacks - 1) * stackStep;
+                auto ringRadius = Cos(latitude);
+                auto normalZ = Sin(latitude);
+                auto z = normalZ * radius + (top ? height / 2.f : -height / 2.f);
+
+                for (uint32_t i = 0; i <= sectors; i++) {
+                    auto angle = static_cast<float>(i) * sectorStep;
+                    glm::vec3 normal{ ringRadius * Cos(angle), ringRadius * Sin(angle), normalZ };
+                    writer.AddVertex({
+                        .Position = { normal.x * radius, normal.y * radius, z },
+                        .Normal = normal,
+                        .Uv = { static_cast<float>(i) / static_cast<float>(sectors), (z + totalLength / 2.f) / totalLength }
+                    });
+                }
+            }
+
+            for (uint32_t ring = 0; ring + 1 < rings; ring++) {
+                for (uint32_t i = 0; i < sectors; i++) {
+                    auto upper = ring * (sectors + 1) + i;
+                    auto lower = upper + sectors + 1;
+
+                    if (ring != 0) {
+                        writer.AddTriangle(upper, lower, upper + 1);
+                    }
+                    if (ring + 2 != rings) {
+                        writer.AddTriangle(upper + 1, lower, lower + 1);
+                    }
+                }
+            }
+        }
+
+        template <Counts counts, typename Generate>
+        constexpr auto buildStatic(Generate generate) {
+            FixedWriter<counts.Vertices, counts.Elements> writer{};
+            generate(writer);
+            return writer.Data;
+        }
+
+        template <typename Generate>
+        MeshData buildDynamic(Generate generate) {
+            DynamicWriter writer{};
+            generate(writer);
+            return std::move(writer.Data);
+        }
+    }
+
+    //Compile time versions, use them to initialize constexpr variables
+
+    constexpr auto MakeCube() {
+        return detail::buildStatic<detail::cubeCounts()>([](auto& writer) { detail::writeCube(writer); });
+    }
+
+    constexpr auto MakePlane() {
+        return detail::buildStatic<detail::planeCounts()>([](auto& writer) { detail::writePlane(writer); });
+    }
+
+    constexpr auto MakePyramid() {
+        return detail::buildStatic<detail::pyramidCounts()>([](auto& writer) { detail::writePyramid(writer); });
+    }
+
+    template <uint32_t Sectors>
+    constexpr auto Cylinder(float radius, float height) {
+        return detail::buildStatic<detail::cylinderCounts(Sectors)>([=](auto& writer) { detail::writeCylinder(writer, Sectors, radius, height); });
+    }
+
+    template <uint32_t Sectors>
+    constexpr auto Cone(float radius, float height) {
+        return detail::buildStatic<detail::coneCounts(Sectors)>([=](auto& writer) { detail::writeCone(writer, Sectors, radius, height); });
+    }
+
+    template <uint32_t Sectors, uint32_t Stacks>
+    constexpr auto UvSphere(float radius) {
+        static_assert(Stacks >= 2, "a UV sphere needs at least two stacks");
+        return detail::buildStatic<detail::uvSphereCounts(Sectors, Stacks)>([=](auto& writer) { detail::writeUvSphere(writer, Sectors, Stacks, radius); });
+    }
+
+    template <uint32_t Subdivisions>
+    constexpr auto Icosphere(float radius) {
+        return detail::buildStatic<detail::icosphereCounts(Subdivisions)>([=](auto& writer) { detail::writeIcosphere(writer, Subdivisions, radius); });
+    }
+
+    template <uint32_t Sectors, uint32_t Sides>
+    constexpr auto Torus(float majorRadius, float minorRadius) {
+        return detail::buildStatic<detail::torusCounts(Sectors, Sides)>([=](auto& writer) { detail::writeTorus(writer, Sectors, Sides, majorRadius, minorRadius); });
+    }
+
+    template <uint32_t Sectors, uint32_t Stacks>
+    constexpr auto Capsule(float radius, float height) {
+        return detail::buildStatic<detail::capsuleCounts(Sectors, Stacks)>([=](auto& writer) { detail::writeCapsule(writer, Sectors, Stacks, radius, height); });
+    }
+
+    //Runtime versions for tessellations that aren't constants
+
+    inline MeshData BuildCylinder(uint32_t sectors, float radius, float height) {
+        return detail::buildDynamic([=](auto& writer) { detail::writeCylinder(writer, sectors, radius, height); });
+    }
+
+    inline MeshData BuildCone(uint32_t sectors, float radius, float height) {
+        return detail::buildDynamic([=](auto& writer) { detail::writeCone(writer, sectors, radius, height); });
+    }
+
+    inline MeshData BuildUvSphere(uint32_t sectors, uint32_t stacks, float radius) {
+        return detail::buildDynamic([=](auto& writer) { detail::writeUvSphere(writer, sectors, stacks, radius); });
+    }
+
+    inline MeshData BuildIcosphere(uint32_t subdivisions, float radius) {
+        return detail::buildDynamic([=](auto& writer) { detail::writeIcosphere(writer, subdivisions, radius); });
+    }
+
+    inline MeshData BuildTorus(uint32_t sectors, uint32_t sides, float majorRadius, float minorRadius) {
+        return detail::buildDynamic([=](auto& writer) { detail::writeTorus(writer, sectors, sides, majorRadius, minorRadius); });
+    }
+
+    inline MeshData BuildCapsule(uint32_t sectors, uint32_t stacks, float radius, float height) {
+        return detail::buildDynamic([=](auto& writer) { detail::writeCapsule(writer, sectors, stacks, radius, height); });
+    }
+
+    //Fixed shapes, built once by the compiler
+    inline constexpr auto Cube = MakeCube();
+    inline constexpr auto Plane = MakePlane();
+    inline constexpr auto Pyramid = MakePyramid();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <rendering/types.h>
+#include <rendering/mesh.h>
+#include <rendering/material.h>
+#include <rendering/frame_snapshot.h>
+#include <game_objects/game_object.h>
+
+class Scene;
+
+//Where a run of batch elements came from, for picking
+struct StaticBatchSource {
+	const GameObject* Object{ nullptr };
+	uint32_t ModelIndex{ 0 };
+	uint32_t FirstElement{ 0 };
+	uint32_t ElementCount{ 0 };
+	BoundingBox Bounds{};
+};
+
+//One merged world space mesh per material
+struct StaticBatch {
+	std::unique_ptr<Mesh> Geometry;
+	//White copy of the source materials, their colors are baked into the vertices
+	MaterialId Material{ 0 };
+	BoundingBox Bounds{};
+	//Lights picked for the whole batch when the scene has more than the shader takes
+	LightSet Lights{};
+
+	//Sorted by FirstElement
+	std::vector<StaticBatchSource> Sources;
+};
+
+//Merges the models of objects flagged IsStatic into a few large meshes.
+//Vertices are pre-transformed into world space and grouped by shader and texture files and the
+//specular parameters; material colors go into the vertex colors, so furniture that only differs
+//in color still ends up in one draw
+class StaticBatcher {
+public:
+	//Needs a current GL context, objects must outlive the batches. Adds one material per batch
+	void Build(const std::vector<std::unique_ptr<GameObject>>& objects, MaterialLibrary& materials);
+
+	const std::vector<StaticBatch>& GetBatches() const { return _batches; }
+
+	//Source object of the triangle starting at element firstElement of a batch, null if out of range
+	const StaticBatchSource* FindSource(uint32_t batchIndex, uint32_t firstElement) const;
+
+	//Per packet lights from the batch bounds, only does work when the scene has more lights than shader slots
+	void AssignLights(const Scene& scene, const std::vector<uint8_t>& batchVisible);
+
+	//Identity model matrix, the vertices are already in world space
+	void GatherDrawPackets(const std::vector<uint8_t>& batchVisible, std::vector<DrawPacket>& packets) const;
+
+private:
+	std::vector<StaticBatch> _batches;
+};
@@ -1,28 +1,24 @@
-#pragma once
-
-#include <game_objects/game_object.h>
-#include <core/model.h>
-
-class Charger : public GameObject {
-public:
-	Charger();
-	void Init() override;
-
-	void Update(float deltaTime) override;
-
-	void Draw(const SceneParameters& sceneParams) override;
-
-	void ProcessLighting(SceneParameters& sceneParam) override;
-
-private:
-	void createShaders();
-
-	void createBody();
-	void createPin();
-private:
-	std::shared_ptr<Shader> _basicUnlitShader{};
-	std::shared_ptr<Mesh> _lightMesh{};
-
-	std::vector<Model> _models{};
-	std::vector<Texture> _textures;
+#pragma once
+
+#include <game_objects/game_object.h>
+#include <core/model.h>
+
+class Charger : public GameObject {
+public:
+	explicit Charger(MaterialLibrary& materials);
+	void Init() override;
+
+	bool Update(float deltaTime) override;
+
+	void ProcessLighting(SceneParameters& sceneParam) override;
+
+private:
+	void createShaders(MaterialLibrary& materials);
+
+	void createBody();
+	void createPin();
+private:
+	std::shared_ptr<Shader> _basicUnlitShader{};
+	MaterialId _material{ 0 };
+	std::shared_ptr<Mesh> _lightMesh{};
 };
\ No newline at end of file
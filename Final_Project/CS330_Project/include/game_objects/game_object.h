@@ -1,14 +1,37 @@
-#pragma once
-#include <glm/glm.hpp>
-#include <rendering/types.h>
-
-class GameObject {
-public:
-	~GameObject() = default;
-	virtual void Init() = 0;
-	virtual void Update(float deltaTime) = 0;
-	virtual void Draw(const SceneParameters& sceneParams) = 0;
-	virtual void ProcessLighting(SceneParameters& sceneParams) = 0;
-public:
-	glm::mat4 Transform{ 1.f }; // default model matrix
-};
\ No newline at end of file
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include <rendering/types.h>
+#include <rendering/texture.h>
+#include <rendering/frame_snapshot.h>
+#include <core/model.h>
+
+class GameObject {
+public:
+	~GameObject() = default;
+	virtual void Init() = 0;
+	//True when the object moved or changed how it looks, idle rendering stops drawing without changes
+	virtual bool Update(float deltaTime) = 0;
+	virtual void ProcessLighting(SceneParameters& sceneParams) = 0;
+
+	const std::vector<Model>& GetModels() const { return _models; }
+
+	//Appends one draw packet per model, the render thread issues them
+	void GatherDrawPackets(std::vector<DrawPacket>& packets);
+
+	//World space box around every model mesh of the object
+	BoundingBox GetWorldBounds() const;
+public:
+	glm::mat4 Transform{ 1.f }; // default model matrix
+
+	// Rasterized into the occlusion buffer, only flag solid box-like objects
+	bool IsOccluder{ false };
+
+	// Never moves after setup, drawn through the static batches instead of its own models
+	bool IsStatic{ false };
+
+protected:
+	std::vector<Model> _models{};
+	//Materials point into this, don't add textures after creating them
+	std::vector<Texture> _textures{};
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <rendering/shader.h>
+
+//Keeps the GPU frame time under a budget by rendering the scene at a lower resolution and scaling
+//it up to the output. Every frame is timed with a pair of GL_TIMESTAMP queries like the GpuProfiler
+//zones, read QueryLatency frames later. The scale drops quickly when the recent frames run over the budget and creeps back up
+//only after a while well under it, so it doesn't flip back and forth at the edge.
+//The scene target is a render graph transient of output size, rendered into its lower left corner,
+//so a scale change is only a viewport change
+class DynamicResolution {
+public:
+	static constexpr uint32_t QueryLatency = 4;
+	static constexpr uint32_t HistorySize = 8;
+	static constexpr float MinScale = 0.5f;
+	static constexpr float MaxScale = 1.f;
+
+	DynamicResolution() = default;
+	~DynamicResolution();
+
+	DynamicResolution(const DynamicResolution&) = delete;
+	DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+	//Render thread, needs a current GL 4.2+ context (sampler binding in the shader)
+	bool Init();
+	void Release();
+
+	//Starts timing the frame, before its first draw
+	void BeginFrame(float budgetMilliseconds);
+	//Stops timing, after the last draw of the frame
+	void EndFrame();
+
+	//Whether the scene renders at less than the output size this frame. At full scale it goes
+	//straight to the output, which saves the copy
+	bool IsScaling() const { return _scaled; }
+	//Scene size for an output of width by height at the current scale
+	glm::ivec2 GetSceneSize(int width, int height) const;
+	//Scales the lower left sceneSize of source up into the bound framebuffer, filling its viewport
+	void Upscale(GLuint source, glm::ivec2 sceneSize, float sharpness);
+
+	float GetScale() const { return _scale; }
+	//GPU time of the latest timed frame
+	double GetGpuMilliseconds() const { return _gpuMilliseconds; }
+
+private:
+	void collect();
+	void updateScale(double milliseconds, float budgetMilliseconds);
+
+private:
+	std::unique_ptr<Shader> _shader;
+	GLuint _vertexArray{ 0 };
+
+	//Begin and end timestamp per frame
+	std::array<GLuint, QueryLatency * 2> _queries{};
+	std::array<bool, QueryLatency> _pending{};
+	uint32_t _frameIndex{ 0 };
+	bool _timing{ false };
+	double _gpuMilliseconds{ 0 };
+
+	//Frame times since the last scale change
+	std::array<double, HistorySize> _history{};
+	uint32_t _historyCount{ 0 };
+	float _scale{ MaxScale };
+	uint32_t _framesOverBudget{ 0 };
+	uint32_t _framesUnderBudget{ 0 };
+	//Timed frames still in flight from before the last scale change, not counted
+	uint32_t _settleFrames{ 0 };
+	float _budgetMilliseconds{ 0.f };
+
+	//This frame
+	bool _scaled{ false };
+};
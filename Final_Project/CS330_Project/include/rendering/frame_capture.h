@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <glad/glad.h>
+
+struct FrameCaptureStats {
+	uint64_t Captured{ 0 };      // frames read back
+	uint64_t Written{ 0 };       // images encoded and saved
+	uint64_t Failed{ 0 };        // images that could not be written
+	uint64_t ReadbackWaits{ 0 }; // captures that found their buffer still waiting for the GPU
+	uint64_t EncoderWaits{ 0 };  // captures that waited for the encoders to catch up
+};
+
+//Saves drawn frames as TGA (.tga) or PNG (any other extension) without stalling the pipeline. glReadPixels goes
+//into one of RingSize persistently mapped pixel buffers and a fence marks when the copy is done;
+//the pixels are taken out RingSize - 1 frames later, when the GPU finished long ago. Encoding runs
+//on EncoderThreads threads of its own, stb_image_write takes longer than a frame
+class FrameCapture {
+public:
+	static constexpr uint32_t RingSize = 3;
+	static constexpr uint32_t EncoderThreads = 2;
+	//Read back frames waiting for an encoder, beyond this the render thread waits instead of
+	//using more memory (a 1080p frame is 8MB)
+	static constexpr uint32_t MaxQueuedImages = 8;
+
+	FrameCapture() = default;
+	~FrameCapture();
+
+	FrameCapture(const FrameCapture&) = delete;
+	FrameCapture& operator=(const FrameCapture&) = delete;
+
+	//Render thread, needs a current GL 4.4 context (persistent mapping)
+	void Init();
+	//Reads back and writes every pending capture, then stops the encoders
+	void Release();
+
+	//Render thread, once per frame after the last draw: hands finished readbacks to the encoders
+	//and starts reading this frame's color buffer when path isn't empty
+	void EndFrame(const std::filesystem::path& path, int width, int height);
+
+	//Any thread
+	FrameCaptureStats GetStats();
+
+private:
+	struct Readback {
+		GLuint Buffer{ 0 };
+		uint8_t* Mapped{ nullptr };
+		int Width{ 0 };
+		int Height{ 0 };
+		GLsync Fence{ nullptr };
+		std::filesystem::path Path{};
+	};
+
+	struct Image {
+		std::vector<uint8_t> Pixels{};
+		int Width{ 0 };
+		int Height{ 0 };
+		std::filesystem::path Path{};
+	};
+
+	void resize(Readback& readback, int width, int height);
+	//Waits for the fence only when wait is set, false when the GPU isn't done yet
+	bool collect(Readback& readback, bool wait);
+	void encoderLoop();
+	static bool writeImage(Image& image);
+
+private:
+	std::array<Readback, RingSize> _ring{};
+	uint32_t _next{ 0 };
+	bool _initialized{ false };
+
+	std::mutex _mutex;
+	std::condition_variable _queued;
+	std::condition_variable _dequeued;
+	std::deque<Image> _images{};
+	std::vector<std::vector<uint8_t>> _freePixels{};
+	bool _stopping{ false };
+	std::vector<std::thread> _encoders{};
+	FrameCaptureStats _stats{};
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <rendering/types.h>
+#include <rendering/material.h>
+
+class Mesh;
+
+//Indices into FrameSnapshot::Lights for one draw
+using LightSet = std::array<uint16_t, MAX_POINT_LIGHTS>;
+
+//Everything needed to issue one draw call, copied out of the scene so the render thread never reads live objects
+struct DrawPacket {
+	static constexpr uint16_t NoLight = std::numeric_limits<uint16_t>::max();
+
+	//Groups packets by program, material then mesh so the submit changes as little state as possible
+	uint64_t SortKey{ 0 };
+
+	Mesh* Geometry{ nullptr };
+	MaterialId Material{ 0 };
+	glm::mat4 Model{ 1.f };
+
+	//Only read when the snapshot uses per packet lights
+	LightSet Lights{};
+};
+
+//One object of the GPU driven path, kept on the GPU between frames
+struct GpuObjectRecord {
+	Mesh* Geometry{ nullptr };
+	MaterialId Material{ 0 };
+	glm::mat4 Model{ 1.f };
+	BoundingBox Bounds{};
+};
+
+//Changes to the GPU object list since the previous snapshot. Snapshots are consumed in order,
+//so the render thread can apply them as deltas
+struct GpuSceneUpdate {
+	bool Enabled{ false };
+
+	//Objects holds the full list (slot i is object i) and replaces the old one
+	bool Rebuild{ false };
+
+	//Without Rebuild: Objects[i] is the new transform and bounds of object Slots[i]
+	std::vector<uint32_t> Slots{};
+	std::vector<GpuObjectRecord> Objects{};
+};
+
+//Primitives drawn without vertex buffers, procedural.vert rebuilds them from gl_VertexID
+//with the same layout as the matching Shapes generator
+enum class ProceduralShape : uint32_t {
+	Plane,
+	Cube,
+	Cylinder
+};
+
+struct ProceduralInstance {
+	ProceduralShape Shape{ ProceduralShape::Cube };
+	//Cylinder side count, instances are drawn in groups of equal vertex count
+	uint32_t Sectors{ 32 };
+	//Cylinder radius and height, plane and cube are unit sized and scaled through Model
+	glm::vec2 Size{ 0.5f, 1.f };
+	MaterialId Material{ 0 };
+	glm::mat4 Model{ 1.f };
+};
+
+//Full instance list, only filled when it changed since the previous snapshot
+struct ProceduralUpdate {
+	bool Changed{ false };
+	std::vector<ProceduralInstance> Instances{};
+};
+
+//Overlay vertex in the layout stb_easy_font writes, position in HUD units (pixels before scaling, y down)
+struct HudVertex {
+	float X{ 0.f };
+	float Y{ 0.f };
+	float Z{ 0.f };
+	uint8_t Color[4]{ 255, 255, 255, 255 };
+};
+static_assert(sizeof(HudVertex) == 16, "HudVertex has to match stb_easy_font's vertex layout");
+
+//Immutable view of one frame, filled by the main thread and consumed by the render thread
+struct FrameSnapshot {
+	int Width{ 0 };
+	int Height{ 0 };
+	glm::vec4 ClearColor{ 0.f, 0.f, 0.f, 1.f };
+	//Vertical blanks per buffer swap, 0 presents right away. Ignored offscreen
+	int SwapInterval{ 1 };
+	//GPU time per frame the scene resolution scales down to meet, 0 always renders at full resolution
+	float GpuBudgetMilliseconds{ 0.f };
+	//Applied while upscaling, 0 to 1
+	float UpscaleSharpness{ 0.25f };
+
+	//Camera, directional light and the shared point lights
+	SceneParameters SceneParams{};
+
+	//Every point light of the scene, packets pick up to MAX_POINT_LIGHTS of them
+	std::vector<PointLightStruct> Lights{};
+	bool PerPacketLights{ false };
+
+	//Every material of the library, only filled when it changed since the previous snapshot.
+	//The render thread keeps its own copy and the GPU buffer in between
+	std::vector<Material> Materials{};
+	bool MaterialsChanged{ false };
+
+	std::vector<DrawPacket> Packets{};
+
+	//Lays down the depth of the packets first, so the lit pass only shades the visible fragments.
+	//DepthOrder is the packets front to back for it, only filled while on
+	bool DepthPrepass{ false };
+	std::vector<uint32_t> DepthOrder{};
+
+	//Drawn after the packets, culled on the GPU
+	GpuSceneUpdate GpuScene{};
+
+	//Drawn after the packets, only their instance data lives on the GPU
+	ProceduralUpdate Procedural{};
+
+	//Performance overlay quads, drawn last. Empty while the HUD is hidden
+	std::vector<HudVertex> Hud{};
+
+	//Saved to this image once drawn, empty for none. Written a few frames later, see FrameCapture
+	std::filesystem::path CapturePath{};
+};
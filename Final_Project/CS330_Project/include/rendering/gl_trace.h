@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+//GL call tracing: swaps the glad function pointers for wrappers that count every call per frame,
+//by entry point and by the subsystem that made it. A shadow of the bind points, parameters and
+//uniforms flags calls that change nothing (binding what is bound, setting an unchanged value).
+//Driver overhead regressions show up in the report without an external GPU debugger
+namespace GlTrace {
+	//Right after gladLoadGLLoader and before any other GL call, the shadow starts from GL's defaults.
+	//Only the thread that has the context current may make GL calls afterwards
+	void Install();
+	bool IsInstalled();
+
+	//Any thread: counts the next frameCount frames, then writes per frame summaries and the top
+	//entry points to path and the top redundant calls to the console
+	void BeginCapture(uint32_t frameCount, const std::filesystem::path& path);
+	//Thread with the context, after the last GL call of a frame
+	void EndFrame();
+
+	//Index for GlTraceScope, names are compared by content
+	uint32_t RegisterSubsystem(const char* name);
+}
+
+//Attributes the GL calls of the calling thread to a subsystem until destroyed
+class GlTraceScope {
+public:
+	explicit GlTraceScope(uint32_t subsystem);
+	~GlTraceScope();
+
+	GlTraceScope(const GlTraceScope&) = delete;
+	GlTraceScope& operator=(const GlTraceScope&) = delete;
+
+private:
+	uint32_t _previous;
+};
+
+//Scopes compile to nothing without CS330_GL_TRACE (set in the Debug preprocessor definitions)
+#define GL_TRACE_CONCAT_INNER(a, b) a##b
+#define GL_TRACE_CONCAT(a, b) GL_TRACE_CONCAT_INNER(a, b)
+
+#ifdef CS330_GL_TRACE
+#define GL_TRACE_SCOPE(name) \
+	static const uint32_t GL_TRACE_CONCAT(glTraceSubsystem, __LINE__) = GlTrace::RegisterSubsystem(name); \
+	GlTraceScope GL_TRACE_CONCAT(glTraceScope, __LINE__){ GL_TRACE_CONCAT(glTraceSubsystem, __LINE__) }
+#else
+#define GL_TRACE_SCOPE(name) ((void)0)
+#endif
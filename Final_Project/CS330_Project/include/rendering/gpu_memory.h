@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <glad/glad.h>
+
+//Bytes of GL storage this program allocated, kept up to date by the code that allocates it.
+//Call Track after every (re)allocation of a buffer or texture and Forget when deleting it
+namespace GpuMemory {
+	enum class Kind : uint8_t {
+		Buffer,
+		Texture,
+		Renderbuffer
+	};
+
+	//Replaces what was tracked for the object before
+	void Track(Kind kind, GLuint name, int64_t bytes);
+	void Forget(Kind kind, GLuint name);
+
+	int64_t GetTotal(Kind kind);
+}
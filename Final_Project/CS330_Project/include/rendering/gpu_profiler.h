@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+
+#include <core/profiler.h>
+
+//GPU zones from GL_TIMESTAMP queries. Every frame gets its own query pool, results are read
+//FrameLatency frames later and only when available, so the CPU never waits on the GPU.
+//The zones land on their own "GPU" track of the profiler, on the CPU timeline
+class GpuProfiler {
+public:
+	static constexpr uint32_t FrameLatency = 4;
+	static constexpr uint32_t MaxZones = 64;
+
+	GpuProfiler() = default;
+	~GpuProfiler();
+
+	GpuProfiler(const GpuProfiler&) = delete;
+	GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+	//Render thread, needs a current GL 3.3+ context (timer queries)
+	bool Init();
+	void Release();
+
+	//Collects the results of the frame that used this pool last, then starts recording into it
+	void BeginFrame();
+	void EndFrame();
+
+	//Returns the zone to pass to EndZone, NoZone when not recording or the pool is full
+	uint32_t BeginZone(const char* name);
+	void EndZone(uint32_t zone);
+
+	static constexpr uint32_t NoZone = ~0u;
+
+private:
+	struct Zone {
+		const char* Name{ nullptr };
+		uint32_t Depth{ 0 };
+	};
+
+	struct FrameQueries {
+		//Begin and end timestamp per zone
+		std::array<GLuint, MaxZones * 2> Queries{};
+		std::vector<Zone> Zones{};
+		//Issued last, zones nest so this is the end of the outermost one rather than of the last zone
+		GLuint LastQuery{ 0 };
+		bool Pending{ false };
+	};
+
+	void collect(FrameQueries& frame);
+	void calibrate();
+
+private:
+	std::array<FrameQueries, FrameLatency> _frames{};
+	uint32_t _frameIndex{ 0 };
+	//Zones of the frame being recorded, null outside of a capture
+	FrameQueries* _current{ nullptr };
+	uint32_t _depth{ 0 };
+
+	//Added to GPU timestamps to get profiler time, measured when a capture starts
+	int64_t _clockOffset{ 0 };
+	bool _wasRecording{ false };
+
+	ProfileTrack* _track{ nullptr };
+	bool _initialized{ false };
+};
+
+//Records a GPU zone around the enclosed GL commands
+class GpuProfileScope {
+public:
+	GpuProfileScope(GpuProfiler& profiler, const char* name)
+		: _profiler{ profiler }, _zone{ profiler.BeginZone(name) } {}
+	~GpuProfileScope() { _profiler.EndZone(_zone); }
+
+	GpuProfileScope(const GpuProfileScope&) = delete;
+	GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+	GpuProfiler& _profiler;
+	uint32_t _zone;
+};
+
+#ifdef CS330_PROFILER
+#define PROFILE_GPU_SCOPE(profiler, name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__){ profiler, name }
+#else
+#define PROFILE_GPU_SCOPE(profiler, name) ((void)0)
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glad/glad.h>
+
+#include <rendering/frame_snapshot.h>
+#include <rendering/shader.h>
+#include <rendering/stream_buffer.h>
+
+//Draws the HUD quads of a snapshot in one indexed draw. Vertices go through the frame's
+//stream buffer region, the index buffer holds the quad pattern once for MaxQuads quads
+class HudRenderer {
+public:
+	static constexpr uint32_t MaxQuads = 16384;
+
+	HudRenderer() = default;
+	~HudRenderer();
+
+	HudRenderer(const HudRenderer&) = delete;
+	HudRenderer& operator=(const HudRenderer&) = delete;
+
+	//Render thread, needs a current GL 4.3+ context (vertex attribute binding)
+	bool Init();
+	void Release();
+
+	//Space to reserve in the stream buffer for these vertices
+	static GLsizeiptr GetStreamSize(const std::vector<HudVertex>& vertices);
+
+	//Blends over whatever was drawn, leaves depth testing and blending as it found them
+	void Draw(const std::vector<HudVertex>& vertices, int width, int height, StreamBuffer& streamBuffer);
+
+private:
+	std::unique_ptr<Shader> _shader;
+	GLuint _vertexArray{ 0 };
+	GLuint _indexBuffer{ 0 };
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <rendering/types.h>
+#include <rendering/frame_snapshot.h>
+#include <rendering/material.h>
+#include <rendering/shader.h>
+
+//GPU driven path: object transforms and bounds live in shader storage buffers, a compute shader
+//frustum culls them and writes one indirect draw command per object, then every material is drawn
+//with a single glMultiDrawElementsIndirect. Per frame CPU work depends on the number of changed
+//objects and materials, not on the number of objects
+class IndirectRenderer {
+public:
+	IndirectRenderer() = default;
+	~IndirectRenderer();
+
+	IndirectRenderer(const IndirectRenderer&) = delete;
+	IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+	//Render thread, needs a current GL 4.3+ context (compute, SSBOs, multi draw indirect)
+	bool Init();
+	void Release();
+
+	//Materials are the render thread's copy, the objects reference them by id
+	void Apply(const GpuSceneUpdate& update, const std::vector<Material>& materials);
+
+	//Writes this frame's draw commands. The draw reading them needs GL_COMMAND_BARRIER_BIT and
+	//GL_SHADER_STORAGE_BARRIER_BIT in between
+	void Cull(const glm::mat4& viewProjection, RenderStats& stats);
+	//FrameData and LightData blocks and the material buffer have to be bound already. Adds its draws to stats
+	void Draw(RenderStats& stats);
+
+	uint32_t GetObjectCount() const { return static_cast<uint32_t>(_objectData.size()); }
+	uint32_t GetMultiDrawCount() const { return static_cast<uint32_t>(_groups.size()); }
+	//Of every object, visible or not
+	uint64_t GetTriangleCount() const { return _triangleCount; }
+
+private:
+	//std430 layouts of the structs in gpu_cull.comp and indirect.vert
+	struct ObjectData {
+		glm::mat4 Model{ 1.f };
+		glm::vec4 BoundsMin{};
+		glm::vec4 BoundsMax{};
+		uint32_t Mesh{ 0 };
+		uint32_t Material{ 0 };
+		uint32_t Padding[2]{};
+	};
+
+	struct MeshData {
+		uint32_t IndexCount{ 0 };
+		uint32_t FirstIndex{ 0 };
+		int32_t BaseVertex{ 0 };
+		uint32_t Padding{ 0 };
+	};
+
+	//Objects whose materials share program and textures sit in consecutive slots, colors come from the material buffer
+	struct MaterialGroup {
+		Shader* Program{ nullptr };
+		std::array<Texture*, 2> Textures{};
+		uint32_t FirstSlot{ 0 };
+		uint32_t SlotCount{ 0 };
+	};
+
+	void rebuild(const std::vector<GpuObjectRecord>& objects, const std::vector<Material>& materials);
+	uint32_t addMesh(const Mesh* mesh);
+	Shader* programFor(const Shader* source);
+	void uploadGeometry();
+
+private:
+	std::unique_ptr<Shader> _cullShader;
+	//indirect.vert linked with each fragment shader in use, by fragment path
+	std::unordered_map<std::string, std::unique_ptr<Shader>> _programs;
+
+	//Geometry arena: every mesh of the path in one vertex and one index buffer
+	GLuint _vertexArray{ 0 };
+	GLuint _vertexBuffer{ 0 };
+	GLuint _indexBuffer{ 0 };
+	GLuint _objectIndexBuffer{ 0 };
+	std::vector<Vertex> _vertices;
+	std::vector<uint32_t> _indices;
+	std::unordered_map<const Mesh*, uint32_t> _meshIndices;
+	std::vector<MeshData> _meshes;
+	bool _geometryDirty{ false };
+
+	GLuint _objectBuffer{ 0 };
+	GLuint _meshBuffer{ 0 };
+	GLuint _commandBuffer{ 0 };
+
+	//CPU mirror of the object buffer, deltas land here and upload as one range
+	std::vector<ObjectData> _objectData;
+	std::vector<uint32_t> _slotOfObject;
+	std::vector<MaterialGroup> _groups;
+	uint64_t _triangleCount{ 0 };
+};
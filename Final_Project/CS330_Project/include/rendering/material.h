@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Shader;
+class Texture;
+
+//Index into a MaterialLibrary, also the row of the material storage buffer the shaders read
+using MaterialId = uint32_t;
+
+//Everything about a surface that isn't geometry. Draws reference materials by index,
+//so one mesh can be drawn in any number of colors and draws sort by material
+struct Material {
+	//Shader variant, its fragment stage reads the parameters below from the material buffer
+	Shader* Program{ nullptr };
+	std::array<Texture*, 2> Textures{};
+
+	//Multiplies the vertex color
+	glm::vec3 Color{ 1.f };
+	float SpecularStrength{ 0.5f };
+	float Shininess{ 32.f };
+	//0 - tex0 only, 0.5 - even mix, 1 - tex1 only
+	float TextureMix{ 0.5f };
+};
+
+//Owns every material of the application, ids stay valid for its lifetime.
+//The render thread keeps a copy, GetVersion tells when it has to be sent again
+class MaterialLibrary {
+public:
+	MaterialId Add(const Material& material);
+	void Set(MaterialId id, const Material& material);
+
+	const Material& Get(MaterialId id) const { return _materials[id]; }
+	const std::vector<Material>& GetMaterials() const { return _materials; }
+	size_t Size() const { return _materials.size(); }
+
+	//Bumped by every Add and Set
+	uint64_t GetVersion() const { return _version; }
+
+private:
+	std::vector<Material> _materials;
+	uint64_t _version{ 0 };
+};
@@ -1,26 +1,63 @@
-#pragma once
-
-#include <vector>
-#include <rendering/types.h>
-#include <glad/glad.h>      // Glad library
-
-class Mesh {
-public:
-	Mesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &elements);
-	Mesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements, const glm::vec3& color);
-
-	void Draw() const;
-
-	glm::mat4 Transform { 1.f };
-
-private:
-	void init(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements);
-
-private:
-
-	uint32_t _elementCount{0};
-	GLuint _vertexArrayObject{};
-	GLuint _vertexBufferObject{};
-	GLuint _shaderProgram{};
-	GLuint _elementBufferObject{};
+#pragma once
+
+#include <span>
+#include <vector>
+#include <rendering/types.h>
+#include <rendering/mesh_processing.h>
+#include <glad/glad.h>      // Glad library
+
+class Mesh {
+public:
+	//Format of meshes that don't ask for one
+	static inline VertexFormat DefaultFormat = VertexFormat::Compact;
+
+	//Takes vectors as well as the constexpr arrays from Shapes. Colors come from the material, so meshes can be shared
+	Mesh(std::span<const Vertex> vertices, std::span<const uint32_t> elements, VertexFormat format = DefaultFormat, const MeshProcessingOptions& processing = {});
+
+	void Draw() const;
+	GLuint GetVertexArray() const { return _vertexArrayObject; }
+
+	VertexFormat GetVertexFormat() const { return _format; }
+	//GL_UNSIGNED_SHORT below 65536 vertices, GL_UNSIGNED_INT otherwise
+	GLenum GetIndexType() const { return _indexType; }
+	uint32_t GetElementCount() const { return _elementCount; }
+	//Vertex plus index buffer size
+	size_t GetGpuBytes() const { return _gpuBytes; }
+
+	//Quantized positions decode as offset + position * scale (DrawData), identity for the other formats
+	const glm::vec3& GetPositionOffset() const { return _positionOffset; }
+	const glm::vec3& GetPositionScale() const { return _positionScale; }
+
+	//Local space bounds of the vertices, before Transform is applied
+	const BoundingBox& GetBounds() const { return _bounds; }
+
+	const MeshProcessingStats& GetProcessingStats() const { return _processingStats; }
+
+	//CPU copy of the uploaded data (welded and reordered), read by static batching
+	const std::vector<Vertex>& GetVertices() const { return _vertices; }
+	const std::vector<uint32_t>& GetElements() const { return _elements; }
+
+	glm::mat4 Transform { 1.f };
+
+private:
+	void init(std::vector<Vertex> vertices, std::vector<uint32_t> elements, const MeshProcessingOptions& processing);
+	void uploadVertices();
+	void uploadElements();
+
+private:
+
+	uint32_t _elementCount{0};
+	VertexFormat _format{ VertexFormat::Compact };
+	GLenum _indexType{ GL_UNSIGNED_INT };
+	size_t _gpuBytes{ 0 };
+	glm::vec3 _positionOffset{ 0.f };
+	glm::vec3 _positionScale{ 1.f };
+	BoundingBox _bounds{};
+	MeshProcessingStats _processingStats{};
+	std::vector<Vertex> _vertices;
+	std::vector<uint32_t> _elements;
+	GLuint _vertexArrayObject{};
+	GLuint _vertexBufferObject{};
+	GLuint _shaderProgram{};
+	GLuint _elementBufferObject{};
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <rendering/types.h>
+
+struct MeshProcessingOptions {
+	//Merge vertices whose attributes match
+	bool Weld{ true };
+
+	//Normals are always generated when a vertex has none, this also replaces authored ones
+	bool RecomputeNormals{ false };
+	//Faces meeting at a sharper angle (radians) keep separate normals
+	float CreaseAngle{ 0.7854f };
+
+	//Forsyth ordering for the post transform cache
+	bool OptimizeVertexCache{ true };
+	//Cluster order so outward facing parts are drawn first
+	bool OptimizeOverdraw{ true };
+	//Vertices in first use order
+	bool OptimizeVertexFetch{ true };
+};
+
+struct MeshProcessingStats {
+	uint32_t VerticesBefore{ 0 };
+	uint32_t VerticesAfter{ 0 };
+	float AcmrBefore{ 0.f };
+	float AcmrAfter{ 0.f };
+};
+
+//Average cache misses per triangle for a FIFO post transform cache; 0.5 is ideal for large grids, 3 means no reuse
+float ComputeAcmr(const std::vector<uint32_t>& elements, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+//Welds, fixes normals and reorders a triangle list in place
+MeshProcessingStats ProcessMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements, const MeshProcessingOptions& options = {});
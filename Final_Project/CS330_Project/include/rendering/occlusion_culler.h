@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <rendering/types.h>
+
+class JobSystem;
+
+struct OcclusionStats {
+	uint32_t OccluderTriangles{ 0 };
+	uint32_t TestedObjects{ 0 };
+	uint32_t CulledObjects{ 0 };
+};
+
+//Software occlusion culling on the CPU:
+//occluder boxes are rasterized into a small depth buffer (SIMD, screen tiles run as jobs),
+//a max-depth mip chain is built from it and object bounds are tested against that chain
+class OcclusionCuller {
+public:
+	static constexpr int TileSize = 32;
+
+	explicit OcclusionCuller(int width = 256, int height = 128);
+
+	void BeginFrame(const glm::mat4& viewProjection);
+
+	//Queue the 12 triangles of a world transformed box as occluder geometry
+	void AddOccluder(const glm::mat4& transform, const BoundingBox& localBounds);
+
+	//Rasterize queued occluders and build the hierarchical depth buffer
+	void RasterizeOccluders(JobSystem& jobs);
+
+	//False only when the box is fully hidden behind rasterized occluders.
+	//Safe to call from several threads once RasterizeOccluders returned
+	bool IsVisible(const BoundingBox& worldBounds) const;
+
+	OcclusionStats GetStats() const;
+
+	int GetWidth() const { return _width; }
+	int GetHeight() const { return _height; }
+
+private:
+	struct ScreenTriangle {
+		glm::vec3 Vertices[3]{};
+		glm::ivec2 Min{};
+		glm::ivec2 Max{};
+	};
+
+	struct DepthLevel {
+		int Width{ 0 };
+		int Height{ 0 };
+		std::vector<float> Depth{};
+	};
+
+	void rasterizeTile(uint32_t tileIndex);
+	void rasterizeTriangle(const ScreenTriangle& triangle, const glm::ivec2& tileMin, const glm::ivec2& tileMax);
+	void buildDepthHierarchy();
+
+private:
+	int _width{ 0 };
+	int _height{ 0 };
+	int _tilesX{ 0 };
+	int _tilesY{ 0 };
+
+	glm::mat4 _viewProjection{ 1.f };
+
+	std::vector<ScreenTriangle> _triangles;
+	std::vector<std::vector<uint32_t>> _tileBins;
+
+	//level 0 is the full resolution depth buffer, each next level keeps the max of 2x2 texels
+	std::vector<DepthLevel> _levels;
+
+	uint32_t _occluderTriangles{ 0 };
+	mutable std::atomic<uint32_t> _testedObjects{ 0 };
+	mutable std::atomic<uint32_t> _culledObjects{ 0 };
+};
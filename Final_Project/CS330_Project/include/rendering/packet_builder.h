@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <rendering/frame_snapshot.h>
+#include <rendering/material.h>
+
+class JobSystem;
+
+//Gather side of the renderer: every job system thread appends packets to its own
+//linear buffer without locking, Merge then sorts them by state into one frame list
+class PacketBuilder {
+public:
+	//Clears the buffers, one per thread of jobs
+	void Begin(const JobSystem& jobs);
+
+	//Only call from the thread with that index, see JobSystem::GetThreadIndex
+	std::vector<DrawPacket>& GetBuffer(uint32_t threadIndex) { return _buffers[threadIndex]; }
+
+	//Computes sort keys per buffer in parallel, then writes every packet in key order
+	void Merge(JobSystem& jobs, const MaterialLibrary& materials, std::vector<DrawPacket>& packets);
+
+	//Packet indices by distance of their world bounds center to eye, nearest first. Draws in this order let
+	//early depth testing reject most of the hidden fragments
+	void SortFrontToBack(const std::vector<DrawPacket>& packets, const glm::vec3& eye, std::vector<uint32_t>& order);
+
+private:
+	std::vector<std::vector<DrawPacket>> _buffers;
+
+	//Sort key and position in the flattened buffers
+	std::vector<std::pair<uint64_t, uint32_t>> _order;
+
+	//Squared distance and packet index
+	std::vector<std::pair<float, uint32_t>> _distances;
+};
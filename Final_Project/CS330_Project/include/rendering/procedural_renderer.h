@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <rendering/frame_snapshot.h>
+#include <rendering/material.h>
+#include <rendering/shader.h>
+
+//Attribute-less path: planes, cubes and cylinders are drawn with no vertex or index buffers.
+//procedural.vert computes position, normal and UV from gl_VertexID and the instance record,
+//so the only memory per primitive is one instance in a storage buffer. Instances of equal
+//shape, tessellation and material program are drawn with one glDrawArraysInstanced
+class ProceduralRenderer {
+public:
+	ProceduralRenderer() = default;
+	~ProceduralRenderer();
+
+	ProceduralRenderer(const ProceduralRenderer&) = delete;
+	ProceduralRenderer& operator=(const ProceduralRenderer&) = delete;
+
+	//Render thread, needs a current GL 4.3+ context (storage buffers)
+	bool Init();
+	void Release();
+
+	//Takes the new instances when the update carries them, then regroups. Call again after the materials changed
+	void Apply(const ProceduralUpdate& update, const std::vector<Material>& materials);
+
+	//FrameData and LightData blocks and the material buffer have to be bound already. Adds its draws to stats
+	void Draw(RenderStats& stats);
+
+	uint32_t GetInstanceCount() const { return static_cast<uint32_t>(_instances.size()); }
+	uint32_t GetDrawCount() const { return static_cast<uint32_t>(_groups.size()); }
+	uint64_t GetTriangleCount() const { return _triangleCount; }
+
+	//Vertices of one instance, non indexed triangles
+	static uint32_t GetVertexCount(ProceduralShape shape, uint32_t sectors);
+
+private:
+	//std430 layout of the Instance struct in procedural.vert
+	struct InstanceData {
+		glm::mat4 Model{ 1.f };
+		glm::vec4 Size{ 0.f };
+		uint32_t Material{ 0 };
+		uint32_t Padding[3]{};
+	};
+
+	struct DrawGroup {
+		ProceduralShape Shape{ ProceduralShape::Cube };
+		uint32_t Sectors{ 0 };
+		Shader* Program{ nullptr };
+		std::array<Texture*, 2> Textures{};
+		uint32_t FirstInstance{ 0 };
+		uint32_t InstanceCount{ 0 };
+	};
+
+	Shader* programFor(const Shader* source);
+
+private:
+	//procedural.vert linked with each fragment shader in use, by fragment path
+	std::unordered_map<std::string, std::unique_ptr<Shader>> _programs;
+
+	//Core profiles need a vertex array bound even when it has no attributes
+	GLuint _vertexArray{ 0 };
+	GLuint _instanceBuffer{ 0 };
+
+	std::vector<ProceduralInstance> _instances;
+	std::vector<DrawGroup> _groups;
+	uint64_t _triangleCount{ 0 };
+};
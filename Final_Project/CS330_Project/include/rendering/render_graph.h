@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <rendering/gpu_profiler.h>
+
+//Handle of a texture, framebuffer or buffer of the graph, only valid for the frame it was made in
+using RenderResource = uint32_t;
+constexpr RenderResource NoResource = ~0u;
+
+struct RenderTextureDesc {
+	int Width{ 0 };
+	int Height{ 0 };
+	//Sized internal format, GL_RGBA8, GL_DEPTH24_STENCIL8...
+	GLenum Format{ GL_RGBA8 };
+
+	bool operator==(const RenderTextureDesc&) const = default;
+};
+
+class RenderGraph;
+
+//What a pass reads and writes, handed to its setup function
+class RenderPassBuilder {
+public:
+	static constexpr uint32_t MaxColorAttachments = 4;
+
+	//Transient texture, exists from the first to the last pass using it. Textures of the same desc
+	//share storage when their lifetimes don't overlap
+	RenderResource CreateTexture(const char* name, const RenderTextureDesc& desc);
+
+	//Sampled texture, or a buffer filled by an earlier pass. barrier is the glMemoryBarrier bits the
+	//read needs when the writer went through image or shader storage, the graph issues them once
+	void Read(RenderResource resource, GLbitfield barrier = 0);
+	//Buffer or texture written outside the framebuffer, by a compute shader or image store
+	void Write(RenderResource resource);
+
+	//Attachments. An imported framebuffer is written as a whole, color and depth to the same handle
+	void WriteColor(RenderResource texture, std::optional<glm::vec4> clear = {});
+	void WriteDepth(RenderResource texture, bool clear = false);
+
+	//Viewport of the pass, the size of its first attachment by default
+	void SetRenderArea(int width, int height);
+	//Kept even when nothing reads what it writes
+	void SetSideEffect();
+
+private:
+	friend class RenderGraph;
+	RenderPassBuilder(RenderGraph& graph, uint32_t pass)
+		: _graph{ graph }, _pass{ pass } {}
+
+	RenderGraph& _graph;
+	uint32_t _pass;
+};
+
+//Frame graph: passes declare what they read and write in a setup function, Execute culls the
+//passes nothing depends on, orders the rest by their reads and writes, works out how long every
+//transient texture lives, gives each one a texture from a pool that outlives the frame and runs
+//the passes with their framebuffer bound, cleared and the viewport set.
+//A read sees the writers added before it, or all of them when none was. Writers of one resource
+//keep the order they were added in, among independent passes the one added first runs first.
+//GL has no placement of textures in shared memory, aliasing here means transients with the same
+//desc and disjoint lifetimes get the same texture. Pool textures unused for MaxUnusedFrames are deleted
+class RenderGraph {
+public:
+	static constexpr uint32_t MaxUnusedFrames = 120;
+
+	using PassFunction = std::function<void(const RenderGraph&)>;
+
+	RenderGraph() = default;
+	~RenderGraph();
+
+	RenderGraph(const RenderGraph&) = delete;
+	RenderGraph& operator=(const RenderGraph&) = delete;
+
+	//Deletes the pooled textures and cached framebuffers
+	void Release();
+
+	//Drops the passes and resources of the previous frame, the pool stays
+	void Reset();
+
+	//Resources made outside the graph. Passes writing them are never culled
+	RenderResource ImportFramebuffer(const char* name, GLuint framebuffer, int width, int height);
+	RenderResource ImportBuffer(const char* name);
+
+	//Setup runs right away, execute during Execute if the pass survives culling
+	void AddPass(const char* name, const std::function<void(RenderPassBuilder&)>& setup, PassFunction execute);
+
+	//Render thread
+	void Execute(GpuProfiler& profiler);
+
+	//Inside a pass: the GL texture behind a texture resource
+	GLuint GetTexture(RenderResource texture) const;
+
+	uint32_t GetPassCount() const { return static_cast<uint32_t>(_passes.size()); }
+	uint32_t GetCulledPassCount() const { return _culledPasses; }
+	uint32_t GetPooledTextureCount() const { return static_cast<uint32_t>(_pool.size()); }
+
+private:
+	friend class RenderPassBuilder;
+
+	enum class ResourceKind : uint8_t {
+		Texture,
+		Framebuffer,
+		Buffer
+	};
+
+	struct Resource {
+		const char* Name{ nullptr };
+		ResourceKind Kind{ ResourceKind::Texture };
+		bool Imported{ false };
+		RenderTextureDesc Desc{};
+		GLuint Framebuffer{ 0 };
+		//This frame: positions of the first and last use in the run order and the pool slot
+		uint32_t FirstUse{ ~0u };
+		uint32_t LastUse{ 0 };
+		uint32_t PoolSlot{ ~0u };
+	};
+
+	struct Access {
+		RenderResource Resource{ NoResource };
+		GLbitfield Barrier{ 0 };
+	};
+
+	struct Pass {
+		const char* Name{ nullptr };
+		PassFunction Run{};
+		std::vector<Access> Reads{};
+		//Attachments included
+		std::vector<RenderResource> Writes{};
+		std::array<RenderResource, RenderPassBuilder::MaxColorAttachments> Colors{ NoResource, NoResource, NoResource, NoResource };
+		std::array<std::optional<glm::vec4>, RenderPassBuilder::MaxColorAttachments> ColorClears{};
+		RenderResource Depth{ NoResource };
+		bool ClearDepth{ false };
+		int Width{ 0 };
+		int Height{ 0 };
+		bool SideEffect{ false };
+		//Passes writing what this one reads or draws over, kept along with it
+		std::vector<uint32_t> Dependencies{};
+		//Passes reading what this one overwrites, only for the order
+		std::vector<uint32_t> RunsAfter{};
+		bool Alive{ false };
+	};
+
+	struct PooledTexture {
+		GLuint Handle{ 0 };
+		RenderTextureDesc Desc{};
+		//Last pass of the current owner this frame, free for a new transient after it
+		uint32_t BusyUntil{ 0 };
+		bool UsedThisFrame{ false };
+		uint32_t UnusedFrames{ 0 };
+	};
+
+	//Color attachments then depth
+	using FramebufferKey = std::array<GLuint, RenderPassBuilder::MaxColorAttachments + 1>;
+
+	void addWrite(uint32_t pass, RenderResource resource);
+	void link();
+	void cull();
+	void sort();
+	void allocate();
+	void releaseUnused();
+	uint32_t acquire(const RenderTextureDesc& desc, uint32_t firstUse, uint32_t lastUse);
+	void bind(const Pass& pass);
+	//Cached by attachments, made on first use
+	GLuint framebufferFor(const Pass& pass);
+
+private:
+	std::vector<Pass> _passes{};
+	std::vector<Resource> _resources{};
+	//Kept passes in the order they run
+	std::vector<uint32_t> _order{};
+	uint32_t _culledPasses{ 0 };
+
+	std::vector<PooledTexture> _pool{};
+	std::map<FramebufferKey, GLuint> _framebuffers{};
+
+	//Execute only, a pass binding the same target as the one before skips the calls
+	std::optional<GLuint> _boundFramebuffer{};
+	std::array<GLint, 4> _viewport{};
+};
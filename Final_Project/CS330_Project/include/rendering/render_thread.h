@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <glad/glad.h>
+
+#include <rendering/dynamic_resolution.h>
+#include <rendering/frame_capture.h>
+#include <rendering/frame_snapshot.h>
+#include <rendering/gpu_profiler.h>
+#include <rendering/hud_renderer.h>
+#include <rendering/indirect_renderer.h>
+#include <rendering/material.h>
+#include <rendering/procedural_renderer.h>
+#include <rendering/render_graph.h>
+#include <rendering/shader.h>
+#include <rendering/stream_buffer.h>
+
+struct GLFWwindow;
+
+//Owns the GL context on its own thread and draws the snapshots built by the main thread.
+//Snapshots rotate through FrameCount slots, so frame N+1 is simulated while frame N is submitted
+class RenderThread {
+public:
+	static constexpr uint32_t FrameCount = 2;
+
+	RenderThread() = default;
+	~RenderThread();
+
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+
+	//The window's context must not be current on the calling thread anymore. Offscreen frames go to
+	//a framebuffer object of the snapshot's size and are never presented, for headless runs
+	void Start(GLFWwindow* window, bool offscreen = false);
+
+	//Draws the frames already submitted, then releases the context
+	void Stop();
+
+	//Main thread: blocks until a slot is no longer read by the render thread
+	FrameSnapshot& BeginFrame();
+	//Main thread: hands the snapshot returned by BeginFrame over to the render thread
+	void SubmitFrame();
+
+	//Stream buffer counters as of the last rendered frame
+	StreamBufferStats GetStreamStats();
+	//Draws and state changes of the last rendered frame
+	RenderStats GetRenderStats();
+
+private:
+	void renderLoop();
+	//False when the frame could not be drawn, nothing to capture or present
+	bool submit(const FrameSnapshot& frame);
+	//Depth only, the packets front to back
+	void drawDepthPrepass(const FrameSnapshot& frame);
+	//Scene pass: packets, GPU culled objects and procedural instances. After a depth pre-pass the
+	//packets only test against its depth
+	void drawScene(const FrameSnapshot& frame, const StreamAllocation& sharedLightData, bool depthPrepass);
+	void updateMaterials(const std::vector<Material>& materials);
+	void resizeOffscreenTarget(int width, int height);
+	void releaseOffscreenTarget();
+
+private:
+	GLFWwindow* _window{ nullptr };
+	bool _offscreen{ false };
+	std::thread _thread;
+
+	std::mutex _mutex;
+	std::condition_variable _frameSubmitted;
+	std::condition_variable _frameRendered;
+	bool _stopping{ false };
+
+	//Frame counters, the slot of a frame is its number modulo FrameCount
+	std::array<FrameSnapshot, FrameCount> _frames{};
+	uint64_t _submittedFrames{ 0 };
+	uint64_t _renderedFrames{ 0 };
+
+	StreamBufferStats _streamStats{};
+	RenderStats _renderStats{};
+
+	//render thread only
+	int _viewportWidth{ 0 };
+	int _viewportHeight{ 0 };
+	//applied with the first snapshot, the driver default varies
+	int _swapInterval{ -1 };
+	GLsizeiptr _uniformAlignment{ 256 };
+	//per frame uniform blocks: camera, lights and one model matrix per draw
+	StreamBuffer _streamBuffer;
+	//objects culled by a compute shader and drawn with multi draw indirect
+	IndirectRenderer _indirectRenderer;
+	//planes, cubes and cylinders built in the vertex shader from instance records alone
+	ProceduralRenderer _proceduralRenderer;
+	//GPU zones for the profiler, read back a few frames late
+	GpuProfiler _gpuProfiler;
+	//performance overlay, one draw from the stream buffer
+	HudRenderer _hudRenderer;
+	//scene render scale under a GPU time budget, upscaled before the HUD
+	DynamicResolution _dynamicResolution;
+	//passes of the frame, rebuilt every frame. Transient targets come from its pool
+	RenderGraph _renderGraph;
+	//position only program of the depth pre-pass
+	std::unique_ptr<Shader> _depthShader;
+	//DrawData block of every packet this frame, written once and bound by both scene passes
+	std::vector<StreamAllocation> _drawData;
+	//screenshots and capture sequences, read back a few frames late and encoded on threads of its own
+	FrameCapture _frameCapture;
+	//counted while submitting, published with the frame
+	RenderStats _frameStats{};
+	//copy of the material library as of the last snapshot that changed it, parameters mirrored in a storage buffer
+	std::vector<Material> _materials;
+	GLuint _materialBuffer{ 0 };
+	//color and depth target of offscreen frames
+	GLuint _offscreenFramebuffer{ 0 };
+	GLuint _offscreenColor{ 0 };
+	GLuint _offscreenDepth{ 0 };
+};
@@ -1,34 +1,46 @@
-#pragma once
-#include <filesystem>
-#include <string>
-#include <GLAD/glad.h>
-#include <glm/glm.hpp>
-#include <rendering/texture.h>
-
-using Path = std::filesystem::path;
-
-class Shader {
-public:
-	static inline Path ShaderPath = std::filesystem::current_path() / "assets" / "shaders";
-	Shader() = default;
-	Shader(const std::string &vertexSource, const std::string &fragmentSource);
-	Shader(const Path &vertexPath, const Path &fragmentPath);
-
-	void Bind();
-
-	void SetVec3(const std::string& uniformName, const glm::vec3& vec3) const;
-	void SetMat4(const std::string& uniformName, const glm::mat4& mat4);
-	void SetInt(const std::string& uniformName, int value);
-	void SetFloat(const std::string& uniformName, float value) const;
-
-	void AddTexture(const std::shared_ptr<Texture>& texture);
-
-private:
-	void load(const std::string &vertexSource, const std::string &fragmentSource);
-	GLint getUniformLocation(const std::string& uniformName) const;
-
-private:
-	GLuint _shaderProgram;
-
-	std::vector < std::shared_ptr<Texture>> _textures;
+#pragma once
+#include <filesystem>
+#include <string>
+#include <GLAD/glad.h>
+#include <glm/glm.hpp>
+#include <rendering/texture.h>
+
+using Path = std::filesystem::path;
+
+class Shader {
+public:
+	static inline Path ShaderPath = std::filesystem::current_path() / "assets" / "shaders";
+	Shader() = default;
+	Shader(const std::string &vertexSource, const std::string &fragmentSource);
+	Shader(const Path &vertexPath, const Path &fragmentPath);
+	//Compute program
+	explicit Shader(const Path &computePath);
+
+	void Bind();
+	GLuint GetHandle() const { return _shaderProgram; }
+	//Empty for shaders built from source strings
+	const Path& GetVertexPath() const { return _vertexPath; }
+	const Path& GetFragmentPath() const { return _fragmentPath; }
+
+	void SetVec2(const std::string& uniformName, const glm::vec2& vec2) const;
+	void SetVec3(const std::string& uniformName, const glm::vec3& vec3) const;
+	void SetMat4(const std::string& uniformName, const glm::mat4& mat4);
+	void SetInt(const std::string& uniformName, int value);
+	void SetUint(const std::string& uniformName, unsigned int value) const;
+	void SetVec4(const std::string& uniformName, const glm::vec4& vec4) const;
+	void SetFloat(const std::string& uniformName, float value) const;
+
+	void AddTexture(const std::shared_ptr<Texture>& texture);
+
+private:
+	void load(const std::string &vertexSource, const std::string &fragmentSource);
+	void loadCompute(const std::string &computeSource);
+	GLint getUniformLocation(const std::string& uniformName) const;
+
+private:
+	GLuint _shaderProgram;
+	Path _vertexPath;
+	Path _fragmentPath;
+
+	std::vector < std::shared_ptr<Texture>> _textures;
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glad/glad.h>
+
+//Sub range of the stream buffer, write through Data and bind with Offset
+struct StreamAllocation {
+	void* Data{ nullptr };
+	GLintptr Offset{ 0 };
+	GLsizeiptr Size{ 0 };
+};
+
+struct StreamBufferStats {
+	uint64_t Waits{ 0 };          // frames that found their region still in use by the GPU
+	double WaitMilliseconds{ 0 }; // time spent in those waits, total
+	double LastWaitMilliseconds{ 0 };
+	GLsizeiptr BytesLastFrame{ 0 };
+	uint32_t Reallocations{ 0 };
+};
+
+//Ring buffer for data written once per frame (uniform blocks, dynamic vertices).
+//The storage is mapped persistently and coherently for its whole lifetime and split into
+//RegionCount regions, one per frame in flight. A fence guards every region, so the CPU
+//only waits when the GPU is still reading the region it is about to overwrite
+class StreamBuffer {
+public:
+	static constexpr uint32_t RegionCount = 3;
+
+	StreamBuffer() = default;
+	~StreamBuffer();
+
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	//Needs a current GL 4.4 context
+	bool Init(GLsizeiptr regionSize);
+	//Call on the context's thread before it goes away, the destructor only cleans up leftovers
+	void Release();
+
+	//Moves to the next region and waits for its fence. Regrows every region
+	//(after the GPU finished all of them) when a frame needs more than regionSize
+	void BeginFrame(GLsizeiptr requiredSize);
+
+	//Data is null when the region is exhausted
+	StreamAllocation Allocate(GLsizeiptr size, GLsizeiptr alignment);
+
+	//Fences everything submitted from the current region
+	void EndFrame();
+
+	GLuint GetHandle() const { return _buffer; }
+	const StreamBufferStats& GetStats() const { return _stats; }
+
+private:
+	void waitForRegion(uint32_t region);
+
+private:
+	GLuint _buffer{ 0 };
+	uint8_t* _mapped{ nullptr };
+	GLsizeiptr _regionSize{ 0 };
+
+	uint32_t _region{ 0 };
+	GLsizeiptr _head{ 0 };
+	std::array<GLsync, RegionCount> _fences{};
+
+	StreamBufferStats _stats{};
+};
@@ -1,12 +1,15 @@
-#pragma once
-#include <filesystem>
-#include <glad/glad.h>
-
-
-class Texture {
-public:
-	explicit Texture(const std::filesystem::path& path);
-	void Bind();
-private:
-	GLuint _textureHandle;
+#pragma once
+#include <filesystem>
+#include <glad/glad.h>
+
+
+class Texture {
+public:
+	explicit Texture(const std::filesystem::path& path);
+	void Bind();
+	GLuint GetHandle() const { return _textureHandle; }
+	const std::filesystem::path& GetPath() const { return _path; }
+private:
+	GLuint _textureHandle;
+	std::filesystem::path _path;
 };
\ No newline at end of file
@@ -1,46 +1,122 @@
-#pragma once
-
-#include <glm/glm.hpp>
-#include <vector>
-
-constexpr uint8_t MAX_POINT_LIGHTS = 4;
-
-struct Vertex {
-    glm::vec3 Position {0.f, 0.f, 0.f};
-    glm::vec3 Color {1.f, 1.f, 1.f};
-    glm::vec3 Normal { 0.f, 0.f, 0.f };
-    glm::vec2 Uv {1.f, 1.f};
-};
-
-struct DirectionalLight {
-    glm::vec3 Direction{};
-
-    glm::vec3 AmbientColor{};
-    glm::vec3 DiffuseColor{};
-    glm::vec3 SpecularColor{};
-
-};
-
-struct PointLightStruct {
-    glm::vec3 Position;
-
-    glm::vec3 AmbientColor{};
-    glm::vec3 DiffuseColor{};
-    glm::vec3 SpecularColor{};
-
-    float Constant{ 1.f };
-    float Linear{ 0.f };
-    float Quadratic{ 0.f };
-};
-
-struct SceneParameters {
-    glm::mat4 ProjectionMatrix{1.f};
-    glm::mat4 ViewMatrix{1.f};
-    
-    glm::vec3 CameraPosition{};
-
-    DirectionalLight DirLight{};
-
-    std::vector<PointLightStruct> Lights{};
-};
-
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include <limits>
+
+constexpr uint8_t MAX_POINT_LIGHTS = 4;
+
+struct Vertex {
+    glm::vec3 Position {0.f, 0.f, 0.f};
+    glm::vec3 Color {1.f, 1.f, 1.f};
+    glm::vec3 Normal { 0.f, 0.f, 0.f };
+    glm::vec2 Uv {1.f, 1.f};
+};
+
+//GPU side layout of a mesh's vertices, Vertex stays the CPU format
+enum class VertexFormat : uint8_t {
+    Float,      // Vertex as is, 44 bytes
+    Compact,    // float position, RGBA8 color, 10_10_10_2 normal, half UVs: 24 bytes
+    Quantized   // Compact with 16 bit positions relative to the mesh bounds: 20 bytes
+};
+
+struct CompactVertex {
+    glm::vec3 Position{};
+    uint32_t Color{};
+    uint32_t Normal{};
+    uint16_t Uv[2]{};
+};
+
+struct QuantizedVertex {
+    uint16_t Position[4]{}; // xyz unorm, w pads the color to 4 bytes
+    uint32_t Color{};
+    uint32_t Normal{};
+    uint16_t Uv[2]{};
+};
+
+static_assert(sizeof(CompactVertex) == 24, "CompactVertex must stay tightly packed");
+static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex must stay tightly packed");
+
+//Axis aligned box, starts empty (Min > Max) so the first Expand sets it
+struct BoundingBox {
+    glm::vec3 Min{ std::numeric_limits<float>::max() };
+    glm::vec3 Max{ -std::numeric_limits<float>::max() };
+
+    bool IsEmpty() const { return Min.x > Max.x; }
+
+    void Expand(const glm::vec3& point) {
+        Min = glm::min(Min, point);
+        Max = glm::max(Max, point);
+    }
+
+    void Expand(const BoundingBox& other) {
+        if (!other.IsEmpty()) {
+            Expand(other.Min);
+            Expand(other.Max);
+        }
+    }
+
+    //Box enclosing this box after transforming all 8 corners
+    BoundingBox Transformed(const glm::mat4& transform) const {
+        BoundingBox result{};
+        if (IsEmpty()) {
+            return result;
+        }
+
+        for (auto i = 0; i < 8; i++) {
+            glm::vec3 corner{
+                (i & 1) ? Max.x : Min.x,
+                (i & 2) ? Max.y : Min.y,
+                (i & 4) ? Max.z : Min.z
+            };
+            result.Expand(glm::vec3(transform * glm::vec4(corner, 1.f)));
+        }
+
+        return result;
+    }
+};
+
+struct DirectionalLight {
+    glm::vec3 Direction{};
+
+    glm::vec3 AmbientColor{};
+    glm::vec3 DiffuseColor{};
+    glm::vec3 SpecularColor{};
+
+};
+
+struct PointLightStruct {
+    glm::vec3 Position{};
+
+    glm::vec3 AmbientColor{};
+    glm::vec3 DiffuseColor{};
+    glm::vec3 SpecularColor{};
+
+    float Constant{ 1.f };
+    float Linear{ 0.f };
+    float Quadratic{ 0.f };
+};
+
+struct SceneParameters {
+    glm::mat4 ProjectionMatrix{1.f};
+    glm::mat4 ViewMatrix{1.f};
+    
+    glm::vec3 CameraPosition{};
+
+    DirectionalLight DirLight{};
+
+    std::vector<PointLightStruct> Lights{};
+};
+
+
+//What the render thread issued for one frame, the HUD's own draw not included
+struct RenderStats {
+    uint32_t DrawCalls{ 0 };        // draws and multi draws
+    uint64_t Triangles{ 0 };        // GPU culled objects count before culling
+    uint32_t ProgramBinds{ 0 };
+    uint32_t TextureBinds{ 0 };
+    double SubmitMilliseconds{ 0 }; // CPU time of the render thread
+    double GpuMilliseconds{ 0 };    // GPU time of a frame DynamicResolution::QueryLatency frames earlier
+    float RenderScale{ 1.f };       // scene resolution relative to the output
+};
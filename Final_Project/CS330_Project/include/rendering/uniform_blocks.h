@@ -0,0 +1,107 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <rendering/types.h>
+#include <rendering/material.h>
+
+//Binding points of the uniform blocks declared in the shaders
+constexpr unsigned int FRAME_BLOCK_BINDING = 0;
+constexpr unsigned int DRAW_BLOCK_BINDING = 1;
+constexpr unsigned int LIGHT_BLOCK_BINDING = 2;
+//Shader storage binding of the material buffer, after the ones the GPU culling pass uses
+constexpr unsigned int MATERIAL_STORAGE_BINDING = 3;
+
+//std140 mirrors of the shader blocks: every vec3 starts on 16 bytes, structs round up to 16
+struct DirLightBlock {
+	glm::vec3 Direction{};
+	float Padding0{};
+	glm::vec3 AmbientColor{};
+	float Padding1{};
+	glm::vec3 DiffuseColor{};
+	float Padding2{};
+	glm::vec3 SpecularColor{};
+	float Padding3{};
+};
+
+struct PointLightBlock {
+	glm::vec3 Position{};
+	float Padding0{};
+	glm::vec3 AmbientColor{};
+	float Padding1{};
+	glm::vec3 DiffuseColor{};
+	float Padding2{};
+	glm::vec3 SpecularColor{};
+	float Constant{ 1.f };
+	float Linear{ 0.f };
+	float Quadratic{ 0.f };
+	float Padding3[2]{};
+};
+
+//FrameData, binding 0
+struct FrameBlock {
+	glm::mat4 Projection{ 1.f };
+	glm::mat4 View{ 1.f };
+	glm::vec3 EyePos{};
+	float Padding0{};
+};
+
+//DrawData, binding 1
+struct DrawBlock {
+	glm::mat4 Model{ 1.f };
+	//Decodes quantized positions, see Mesh::GetPositionOffset
+	glm::vec4 PositionOffset{ 0.f };
+	glm::vec4 PositionScale{ 1.f };
+	//Row of the material buffer
+	uint32_t MaterialIndex{ 0 };
+	uint32_t Padding0[3]{};
+};
+
+//LightData, binding 2
+struct LightBlock {
+	DirLightBlock DirLight{};
+	PointLightBlock PointLights[MAX_POINT_LIGHTS]{};
+};
+
+//MaterialData, std430 storage buffer at MATERIAL_STORAGE_BINDING, one per MaterialId
+struct MaterialBlock {
+	glm::vec4 Color{ 1.f };
+	float SpecularStrength{ 0.5f };
+	float Shininess{ 32.f };
+	float TextureMix{ 0.5f };
+	float Padding0{};
+};
+
+static_assert(sizeof(PointLightBlock) == 80, "PointLightBlock must match the std140 layout");
+static_assert(sizeof(FrameBlock) == 144, "FrameBlock must match the std140 layout");
+static_assert(sizeof(DrawBlock) == 112, "DrawBlock must match the std140 layout");
+static_assert(sizeof(MaterialBlock) == 32, "MaterialBlock must match the std430 layout");
+
+inline DirLightBlock ToBlock(const DirectionalLight& light) {
+	DirLightBlock block{};
+	block.Direction = light.Direction;
+	block.AmbientColor = light.AmbientColor;
+	block.DiffuseColor = light.DiffuseColor;
+	block.SpecularColor = light.SpecularColor;
+	return block;
+}
+
+inline PointLightBlock ToBlock(const PointLightStruct& light) {
+	PointLightBlock block{};
+	block.Position = light.Position;
+	block.AmbientColor = light.AmbientColor;
+	block.DiffuseColor = light.DiffuseColor;
+	block.SpecularColor = light.SpecularColor;
+	block.Constant = light.Constant;
+	block.Linear = light.Linear;
+	block.Quadratic = light.Quadratic;
+	return block;
+}
+
+inline MaterialBlock ToBlock(const Material& material) {
+	MaterialBlock block{};
+	block.Color = glm::vec4(material.Color, 1.f);
+	block.SpecularStrength = material.SpecularStrength;
+	block.Shininess = material.Shininess;
+	block.TextureMix = material.TextureMix;
+	return block;
+}
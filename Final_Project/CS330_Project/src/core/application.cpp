@@ -1,352 +1,921 @@
-#include <core/application.h>    
-#include <iostream>
-#include <glm/glm.hpp>
-#include <vector>
-#include <glm/gtc/matrix_transform.hpp>
-#include <core/camera.h>
-#include <stb_image.h>
-#include <game_objects/pointLight.h>
-#include <game_objects/tableTop.h>
-#include <game_objects/computer.h>
-#include <game_objects/peanutJar.h>
-#include <game_objects/tableLight.h>
-#include <game_objects/charger.h>
-#include <game_objects/calculator.h>
-#include <core/shapes.h> // temp, see if needed
-
-Application::Application(std::string WindowTitle, int width, int height) 
-    : _applicationName{/*std::move( WindowTitle )*/WindowTitle}, _width{ width }, _height{ height },
-    //camera's width, height, initial-position, and perspective true or false
-    _camera{ width, height, {0.f, 0.f, 3.f}, true},
-    _cameraLookSpeed {0.15f, 0.15f}
-{}
-
-void Application::Run() {
-	//Open window
-    if (!openWindow()) {
-        return;
-    }
-
-    //Set up inputs
-    setupInputs();
-
-    _running = true;
-
-    //Set up scene
-    setUpScene();
-
-	// Run application
-	while (_running) {
-        //calculate delta time based on computer speed - 
-        //how fast computer returns current time
-        float currentTime = glfwGetTime();
-
-        if (_lastFrameTime == -1.f) {
-            _lastFrameTime = currentTime;
-        }
-
-        auto deltaTime = currentTime - _lastFrameTime;
-        _lastFrameTime = currentTime;
-
-        if (glfwWindowShouldClose(_window)) {
-            _running = false;
-            continue;
-        }
-
-        //Update application with delta time
-        update(deltaTime);
-
-        // Draw
-        draw();
-	}
-
-    glfwTerminate();
-}
-
-bool Application::openWindow() {
-    // GLFW: initialize and configure
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-    // GLFW: window creation
-    _window = glfwCreateWindow(800, 600, "CS330_OpenGL_Project", nullptr, nullptr);
-
-    if (!_window)
-    {
-        std::cerr << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
-    }
-
-    glfwMakeContextCurrent(_window);
-    glfwSetWindowUserPointer(_window, (void*)this);
-
-    // GFLW: whenever the window size changes
-    glfwSetFramebufferSizeCallback(_window, [](GLFWwindow* window, int width, int height) {
-        glViewport(0, 0, width, height);
-
-        auto app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
-
-        app->_width = width;
-        app->_height = height;
-
-        app->_camera.SetSize(width, height);
-    });
-
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cerr << "Failed to create GLAD window" << std::endl;
-        glfwTerminate();
-        return false;
-    }
-
-    // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
-
-    // Cull back faces
-    glFrontFace(GL_CCW);
-    glCullFace(GL_BACK);
-    glFrontFace(GL_CULL_FACE);
-
-    return true;
-}
-
-void Application::setupInputs() {
-    //app gets pressed key
-    glfwSetKeyCallback(_window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
-        auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
-        
-        switch (key) {
-            case GLFW_KEY_ESCAPE: {
-                if (action == GLFW_PRESS) {
-                    app->_running = false;
-                }
-                break;
-            }
-            case GLFW_KEY_P: {
-                if (action == GLFW_PRESS) {
-                    app->_camera.SetIsPerspective(!app->_camera.isPerspective());
-                }
-                break;
-            }
-            default: {}
-        }
-    });
-
-    //app gets mouse position
-    glfwSetCursorPosCallback(_window, [](GLFWwindow* window, double xpos, double ypos) {
-        auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
-    });
-
-    //app gets mouse scroll offsets to contol camera's field of view amount 
-    //for camera zoom in and out
-    glfwSetScrollCallback(_window, [](GLFWwindow* window, double xOffset, double yOffset) {
-        auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
-        app->_camera.IncrementZoom(yOffset * 2);
-        //std::cout << "Mouse wheel (" << xOffset << "," << yOffset << ")" << std::endl;
-    });
-
-    //mouse scroll offsets
-    glfwSetMouseButtonCallback(_window, [](GLFWwindow* window, int button, int action, int mods) {
-        //auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
-        //app->mousePositionCallback(xpos, ypos);
-        //std::cout << "Button (" << button << "," << action << ")" << std::endl;
-        switch (button) {
-            case GLFW_MOUSE_BUTTON_LEFT: {
-                if (action == GLFW_PRESS) {
-                    std::cout << "mouse left button pressed" << std::endl;
-                }
-                else {
-
-                }
-                break;
-            }
-            case GLFW_MOUSE_BUTTON_MIDDLE: {
-                if (action == GLFW_PRESS) {
-
-                }
-                else {
-
-                }
-                break;
-            }
-            case GLFW_MOUSE_BUTTON_RIGHT: {
-                if (action == GLFW_PRESS) {
-
-                }
-                else {
-
-                }
-                break;
-            }
-
-            default: 
-                std::cout << "unhandle mouse button event" << std::endl;
-        }
-
-    });
-
-}
-
-
-void Application::setUpScene()
-{
-    //LIGHT 1: 
-    auto &light = _objects.emplace_back(std::make_unique<PointLight>());
-    light->Transform = glm::translate(light->Transform, glm::vec3(-2.f, 1.f, 1.f));
-
-    auto* castLight = reinterpret_cast<PointLight*>(light.get());
-    castLight->AmbientColor = { 0.f, 0.f, 0.f };
-    castLight->DiffuseColor = { 1.f, 1.f, 1.f };
-    castLight->SpecularColor = { 1.f, 1.f, 1.f };
-    
-    castLight->Constant = 1.f;
-    castLight->Linear = 0.35f;
-    castLight->Quadratic = 0.44f;
-    
-    //LIGHT 2: 
-    auto& light2 = _objects.emplace_back(std::make_unique<PointLight>());
-    light2->Transform = glm::translate(light2->Transform, glm::vec3(2.f, 0.f, 1.f));
-
-    auto* castLight2 = reinterpret_cast<PointLight*>(light2.get());
-    castLight2->AmbientColor = { 0.0f, 0.0f, 0.0f };
-    castLight2->DiffuseColor = { 1.f, 0.f, 0.f };
-    castLight2->SpecularColor = { 1.f, 0.f, 0.f };
-
-    castLight2->Constant = 1.f;
-    castLight2->Linear = 0.007f;
-    castLight2->Quadratic = 0.0002f;
-
-    //TABLE TOP 
-    auto& tableTop = _objects.emplace_back(std::make_unique<TableTop>());
-
-    //COMPUTER
-    auto& computer = _objects.emplace_back(std::make_unique<Computer>());
-    computer->Transform = glm::translate(computer->Transform, glm::vec3(0.f, 0.f, 0.25f));
-
-    //PEANUT JAR
-    auto& peanutJar = _objects.emplace_back(std::make_unique<PeanutJar>());
-    peanutJar->Transform = glm::translate(peanutJar->Transform, glm::vec3(1.5f, -0.46f, 0.f));
-    peanutJar->Transform = glm::rotate(peanutJar->Transform, glm::radians(90.f), glm::vec3(1, 0, 0));
-
-    //TABLE LIGHT
-    auto& tableLight = _objects.emplace_back(std::make_unique<TableLight>());
-    tableLight->Transform = glm::translate(tableLight->Transform, glm::vec3(0.f, -0.844f, 0.f));
-
-    //CHARGER
-    auto& charger = _objects.emplace_back(std::make_unique<Charger>());
-    charger->Transform = glm::translate(charger->Transform, glm::vec3(-1.8f, -0.975f, 0.f));
-    charger->Transform = glm::rotate(charger->Transform, glm::radians(45.f), glm::vec3(0, 1, 0));
-
-    //CALCULATOR
-    auto& calculator = _objects.emplace_back(std::make_unique<Calculator>());
-    calculator->Transform = glm::translate(calculator->Transform, glm::vec3(-1.8f, -0.975f, 1.f));
-}
-
-bool Application::update(float deltaTime)
-{
-    //poll IO events (keys pressed/released, mouse moved etc.)
-    glfwPollEvents();
-
-    handleInput(deltaTime);
-
-    //objects update per frame
-    for (auto& object : _objects) {
-        object->Update(deltaTime);
-    }
-
-    return false;
-}
-
-bool Application::draw()
-{
-    //BG COLOR 
-    // Sets the background color of the window to black (it will be implicitely used by glClear)
-    glClearColor(0.2, 0.196f, 0.184f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    // Get Camera View Matrix
-    glm::mat4 view = _camera.GetViewMatrix();
-    // Get Camera Projection Matrix
-    glm::mat4 projection = _camera.GetProjectionMatrix(); 
-
-    SceneParameters sceneParams{
-        .ProjectionMatrix = projection,
-        .ViewMatrix = view,
-        .CameraPosition = _camera.GetPosition(),
-        .DirLight = {
-            .Direction = glm::normalize(glm::vec3{-0.2f, -0.5f, 1.f}),
-            .AmbientColor = {0.1f, 0.2f, 0.05f},
-            .DiffuseColor = {1.f, 0.9f, 0.9f},
-            .SpecularColor = {1.f, 0.9f, 0.9f}
-        }
-    };
-    
-    //Process lighting for all models
-    for (auto& model : _objects) {
-        model->ProcessLighting(sceneParams);
-    }
-
-    //Draw all game_object models
-    for (auto& model : _objects) {
-        model->Draw(sceneParams);
-    }
-
-    // glfw: swap buffers
-    glfwSwapBuffers(_window);
-
-    return false;
-}
-
-void Application::handleInput(float deltaTime) {
-    //contols frame redraw rate affected computer processing power
-
-    auto moveAmount = _moveSpeed * deltaTime;
-
-    if (glfwGetKey(_window, GLFW_KEY_W)) {
-        _camera.MoveCamera(Camera::MoveDirection::Forward, moveAmount);
-    }
-    if (glfwGetKey(_window, GLFW_KEY_S)) {
-        _camera.MoveCamera(Camera::MoveDirection::Backward, moveAmount);
-    }
-    if (glfwGetKey(_window, GLFW_KEY_A)) {
-        _camera.MoveCamera(Camera::MoveDirection::Left, moveAmount);
-    }
-    if (glfwGetKey(_window, GLFW_KEY_D)) {
-        _camera.MoveCamera(Camera::MoveDirection::Right, moveAmount);
-    }
-    if (glfwGetKey(_window, GLFW_KEY_Q)) {
-        _camera.MoveCamera(Camera::MoveDirection::Up, moveAmount);
-    }
-    if (glfwGetKey(_window, GLFW_KEY_E)) {
-        _camera.MoveCamera(Camera::MoveDirection::Down, moveAmount);
-    }
-
-    double xpos, ypos;
-    glfwGetCursorPos(_window, &xpos, &ypos);
-
-    mousePositionCallback(xpos, ypos);
-}
-
-void Application::mousePositionCallback(double xpos, double ypos) {
-    if (!_firstMouse) {
-        _lastMousePosition.x = static_cast<float>(xpos);
-        _lastMousePosition.y = static_cast<float>(ypos);
-
-        _firstMouse = true;
-    };
-
-    glm::vec2 moveAmount{
-        xpos - _lastMousePosition.x,
-        _lastMousePosition.y - ypos
-    };
-
-    _lastMousePosition.x = static_cast<float>(xpos);
-    _lastMousePosition.y = static_cast<float>(ypos);
-
-    _camera.RotateBy(moveAmount.x * _cameraLookSpeed.x, moveAmount.y * _cameraLookSpeed.y);
-}
-
-
-
-
+#include <core/application.h>    
+#include <iostream>
+#include <glm/glm.hpp>
+#include <vector>
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include <core/camera.h>
+#include <stb_image.h>
+#include <game_objects/tableTop.h>
+#include <game_objects/computer.h>
+#include <game_objects/tableLight.h>
+#include <game_objects/charger.h>
+#include <core/shapes.h> // temp, see if needed
+#include <core/profiler.h>
+#include <rendering/gpu_memory.h>
+#include <rendering/gl_trace.h>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <unordered_set>
+
+namespace {
+    //Local time as 20261019_153012, names captures so they sort and never overwrite each other
+    std::string captureTimestamp() {
+        auto now = std::time(nullptr);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        char text[32];
+        std::strftime(text, sizeof(text), "%Y%m%d_%H%M%S", &local);
+        return text;
+    }
+}
+
+Application::Application(std::string WindowTitle, int width, int height, const LaunchOptions& options) 
+    : _applicationName{/*std::move( WindowTitle )*/WindowTitle}, _width{ width }, _height{ height },
+    //camera's width, height, initial-position, and perspective true or false
+    _camera{ width, height, {0.f, 0.f, 3.f}, true},
+    _cameraLookSpeed {0.15f, 0.15f},
+    _launchOptions{ options },
+    _benchmark{ options.Benchmark },
+    _swapInterval{ static_cast<int>(options.SwapInterval) },
+    _gpuBudget{ options.GpuBudgetMilliseconds },
+    _depthPrepass{ options.DepthPrepass },
+    _captureDirectory{ options.CaptureDirectory }
+{
+    //Headless runs render at the requested size whatever the window ends up as
+    if (_benchmark.IsEnabled()) {
+        _width = options.Benchmark.Width;
+        _height = options.Benchmark.Height;
+        _camera.SetSize(_width, _height);
+    }
+}
+
+void Application::Run() {
+    PROFILE_THREAD("Main");
+
+	//Open window
+    if (!openWindow()) {
+        return;
+    }
+
+    //Set up inputs
+    setupInputs();
+
+    //Replays must start from the same scene state as the recording, open both before anything moves
+    if (!_launchOptions.ReplayInput.empty() && !_inputPlayer.Load(_launchOptions.ReplayInput)) {
+        glfwTerminate();
+        return;
+    }
+    if (!_launchOptions.RecordInput.empty() && !_inputRecorder.Open(_launchOptions.RecordInput)) {
+        glfwTerminate();
+        return;
+    }
+
+    _running = true;
+
+    //Set up scene
+    setUpScene();
+
+    //Snapshots carry the viewport size, start from the real framebuffer size
+    if (!_benchmark.IsEnabled()) {
+        glfwGetFramebufferSize(_window, &_width, &_height);
+        _camera.SetSize(_width, _height);
+    }
+
+    //GL resources exist now, the render thread takes over the context
+    glfwMakeContextCurrent(nullptr);
+    _renderThread.Start(_window, _benchmark.IsEnabled());
+
+    //Benchmarks measure how fast frames can go
+    if (!_benchmark.IsEnabled()) {
+        _framePacer.SetTargetRate(_launchOptions.TargetFrameRate);
+    }
+
+	// Run application
+	while (_running) {
+        //calculate delta time based on computer speed - 
+        //how fast computer returns current time
+        float currentTime = glfwGetTime();
+
+        if (_lastFrameTime == -1.f) {
+            _lastFrameTime = currentTime;
+        }
+
+        auto measuredDelta = currentTime - _lastFrameTime;
+        _lastFrameTime = currentTime;
+
+        //Benchmark and fixed step frames all simulate the same step, the work per frame must not depend on the machine.
+        //Replays override this with the recorded step
+        auto deltaTime = _benchmark.IsEnabled() || _launchOptions.FixedStep ? Benchmark::FrameDelta : measuredDelta;
+
+        if (glfwWindowShouldClose(_window)) {
+            _running = false;
+            continue;
+        }
+
+        {
+            PROFILE_SCOPE("Frame");
+
+            //Update application with delta time
+            auto updateStart = glfwGetTime();
+            update(deltaTime);
+
+            // Draw
+            auto drawStart = glfwGetTime();
+            draw();
+
+            auto frameEnd = glfwGetTime();
+            _updateMilliseconds = (drawStart - updateStart) * 1000.0;
+            _drawMilliseconds = (frameEnd - drawStart) * 1000.0;
+            _hud.AddFrameTime(measuredDelta * 1000.0);
+
+            //Draw waits for a free snapshot slot, so the frame time includes the render thread falling behind
+            if (_benchmark.IsEnabled()) {
+                _benchmark.AddFrame((frameEnd - updateStart) * 1000.0, _updateMilliseconds, _drawMilliseconds, _renderThread.GetRenderStats());
+            }
+        }
+
+        //Sleeps off the rest of the frame when a target rate is set
+        _framePacer.Wait();
+
+        if (waitWhileIdle()) {
+            //The first frame after idling advances one step, not the whole time spent waiting
+            _lastFrameTime = static_cast<float>(glfwGetTime()) - SimulationStep;
+        }
+
+        //A replay inside a benchmark ends it early, the recorded workload is the one to measure
+        if (_benchmark.IsDone() || (_benchmark.IsEnabled() && _inputPlayer.IsDone())) {
+            //Memory and stream counters as of the last frame, before the render thread releases its objects
+            _benchmark.Report(_renderThread.GetStreamStats());
+            _running = false;
+        }
+
+        if (_inputPlayer.IsDone()) {
+            std::cerr << "input: replay finished" << std::endl;
+            _running = false;
+        }
+
+        //Counts down a running capture and writes the trace after its last frame
+        Profiler::EndFrame();
+	}
+
+    //Finish the frames in flight and take the context back for cleanup
+    _renderThread.Stop();
+
+    auto streamStats = _renderThread.GetStreamStats();
+    std::cerr << "stream buffer: " << streamStats.Waits << " GPU waits, " << streamStats.WaitMilliseconds << " ms total, "
+        << streamStats.Reallocations << " reallocations" << std::endl;
+    glfwMakeContextCurrent(_window);
+
+    glfwTerminate();
+}
+
+bool Application::openWindow() {
+    // GLFW: initialize and configure
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4); // 4.4 for persistent mapped buffers (glBufferStorage)
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    //Headless: never shown, frames go to an offscreen framebuffer. Mesa's llvmpipe provides the
+    //context on machines without a GPU (under xvfb-run when there is no display either)
+    if (_benchmark.IsEnabled()) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+
+    // GLFW: window creation
+    _window = glfwCreateWindow(_width, _height, _applicationName.c_str(), nullptr, nullptr);
+
+    if (!_window)
+    {
+        std::cerr << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return false;
+    }
+
+    glfwMakeContextCurrent(_window);
+    glfwSetWindowUserPointer(_window, (void*)this);
+
+    // GFLW: whenever the window size changes
+    //The render thread applies the new viewport with the next snapshot
+    glfwSetFramebufferSizeCallback(_window, [](GLFWwindow* window, int width, int height) {
+        auto app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+
+        app->_width = width;
+        app->_height = height;
+
+        app->_camera.SetSize(width, height);
+        app->_redrawRequested = true;
+    });
+
+    //Uncovered or restored, the window's contents have to be drawn again
+    glfwSetWindowRefreshCallback(_window, [](GLFWwindow* window) {
+        auto app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+        app->_redrawRequested = true;
+    });
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Failed to create GLAD window" << std::endl;
+        glfwTerminate();
+        return false;
+    }
+
+#ifdef CS330_GL_TRACE
+    //Before the first GL call, the call counters start from GL's default state
+    GlTrace::Install();
+#endif
+
+    // Enable depth testing
+    glEnable(GL_DEPTH_TEST);
+
+    // Cull back faces
+    glFrontFace(GL_CCW);
+    glCullFace(GL_BACK);
+    glFrontFace(GL_CULL_FACE);
+
+    return true;
+}
+
+void Application::setupInputs() {
+    //app gets pressed key
+    glfwSetKeyCallback(_window, [](GLFWwindow* window, int key, int, int action, int) {
+        auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+
+        if (action != GLFW_PRESS) {
+            return;
+        }
+
+        app->_redrawRequested = true;
+
+        //Quitting stays live during replays, every other key acts through the frame's input
+        if (key == GLFW_KEY_ESCAPE) {
+            app->_running = false;
+        }
+        else {
+            app->_input.Presses.push_back(static_cast<int16_t>(key));
+        }
+    });
+
+    //app gets mouse position
+    //The cursor is polled every frame, this only wakes up idle rendering
+    glfwSetCursorPosCallback(_window, [](GLFWwindow* window, double, double) {
+        auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+        app->_redrawRequested = true;
+    });
+
+    //app gets mouse scroll offsets to contol camera's field of view amount 
+    //for camera zoom in and out
+    glfwSetScrollCallback(_window, [](GLFWwindow* window, double, double yOffset) {
+        auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+        app->_input.Scroll += static_cast<float>(yOffset);
+        app->_redrawRequested = true;
+        //std::cout << "Mouse wheel (" << xOffset << "," << yOffset << ")" << std::endl;
+    });
+
+    //mouse scroll offsets
+    glfwSetMouseButtonCallback(_window, [](GLFWwindow*, int button, int action, int) {
+        //auto* app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+        //app->mousePositionCallback(xpos, ypos);
+        //std::cout << "Button (" << button << "," << action << ")" << std::endl;
+        switch (button) {
+            case GLFW_MOUSE_BUTTON_LEFT: {
+                if (action == GLFW_PRESS) {
+
+                }
+                else {
+
+                }
+                break;
+            }
+            case GLFW_MOUSE_BUTTON_MIDDLE: {
+                if (action == GLFW_PRESS) {
+
+                }
+                else {
+
+                }
+                break;
+            }
+            case GLFW_MOUSE_BUTTON_RIGHT: {
+                if (action == GLFW_PRESS) {
+
+                }
+                else {
+
+                }
+                break;
+            }
+
+            default: 
+                break;
+        }
+
+    });
+
+}
+
+
+void Application::setUpScene()
+{
+    //shared meshes, shaders and textures for the component based objects
+    _prefabs.Load(_materials);
+
+    //LIGHT 1: 
+    _prefabs.SpawnPointLight(_scene, glm::vec3(-2.f, 1.f, 1.f), {
+        .AmbientColor = { 0.f, 0.f, 0.f },
+        .DiffuseColor = { 1.f, 1.f, 1.f },
+        .SpecularColor = { 1.f, 1.f, 1.f },
+        .Constant = 1.f,
+        .Linear = 0.35f,
+        .Quadratic = 0.44f
+    });
+
+    //LIGHT 2: 
+    _prefabs.SpawnPointLight(_scene, glm::vec3(2.f, 0.f, 1.f), {
+        .AmbientColor = { 0.0f, 0.0f, 0.0f },
+        .DiffuseColor = { 1.f, 0.f, 0.f },
+        .SpecularColor = { 1.f, 0.f, 0.f },
+        .Constant = 1.f,
+        .Linear = 0.007f,
+        .Quadratic = 0.0002f
+    });
+
+    //TABLE TOP 
+    auto& tableTop = _objects.emplace_back(std::make_unique<TableTop>(_materials));
+    tableTop->IsOccluder = true;
+    tableTop->IsStatic = true;
+
+    //COMPUTER
+    auto& computer = _objects.emplace_back(std::make_unique<Computer>(_materials));
+    computer->Transform = glm::translate(computer->Transform, glm::vec3(0.f, 0.f, 0.25f));
+    computer->IsOccluder = true;
+    computer->IsStatic = true;
+
+    //PEANUT JAR
+    _prefabs.SpawnPeanutJar(_scene, glm::vec3(1.5f, -0.46f, 0.f), glm::angleAxis(glm::radians(90.f), glm::vec3(1, 0, 0)));
+
+    //TABLE LIGHT
+    auto& tableLight = _objects.emplace_back(std::make_unique<TableLight>(_materials));
+    tableLight->Transform = glm::translate(tableLight->Transform, glm::vec3(0.f, -0.844f, 0.f));
+    tableLight->IsStatic = true;
+
+    //CHARGER
+    auto& charger = _objects.emplace_back(std::make_unique<Charger>(_materials));
+    charger->Transform = glm::translate(charger->Transform, glm::vec3(-1.8f, -0.975f, 0.f));
+    charger->Transform = glm::rotate(charger->Transform, glm::radians(45.f), glm::vec3(0, 1, 0));
+    charger->IsStatic = true;
+
+    //CALCULATOR
+    _prefabs.SpawnCalculator(_scene, glm::vec3(-1.8f, -0.975f, 1.f));
+
+    //Static objects are placed, merge them into a few world space meshes
+    _staticBatcher.Build(_objects, _materials);
+
+    if (_launchOptions.MeshStats) {
+        reportMeshStats();
+    }
+}
+
+void Application::reportMeshStats() const {
+    //Objects and renderables share meshes, each one is listed once
+    std::vector<std::pair<const char*, const Mesh*>> meshes;
+    std::unordered_set<const Mesh*> listed;
+    auto add = [&](const char* source, const Mesh* mesh) {
+        if (mesh && listed.insert(mesh).second) {
+            meshes.emplace_back(source, mesh);
+        }
+    };
+
+    for (const auto& object : _objects) {
+        for (const auto& model : object->GetModels()) {
+            add("object", model.GetMesh());
+        }
+    }
+    for (const auto* mesh : _scene.Renderables.Meshes) {
+        add("renderable", mesh);
+    }
+    for (const auto& batch : _staticBatcher.GetBatches()) {
+        add("batch", batch.Geometry.get());
+    }
+
+    //Totals weighted by triangles, big meshes matter more to the vertex cache
+    uint64_t triangles = 0;
+    double missesBefore = 0.0;
+    double missesAfter = 0.0;
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const auto& [source, mesh] = meshes[i];
+        const auto& stats = mesh->GetProcessingStats();
+        auto meshTriangles = mesh->GetElementCount() / 3;
+
+        std::cerr << "mesh " << i << " (" << source << "): " << meshTriangles << " triangles, " << stats.VerticesBefore << " -> "
+            << stats.VerticesAfter << " vertices, ACMR " << stats.AcmrBefore << " -> " << stats.AcmrAfter << std::endl;
+
+        triangles += meshTriangles;
+        missesBefore += static_cast<double>(stats.AcmrBefore) * meshTriangles;
+        missesAfter += static_cast<double>(stats.AcmrAfter) * meshTriangles;
+    }
+
+    if (triangles > 0) {
+        std::cerr << "meshes: " << meshes.size() << ", " << triangles << " triangles, ACMR " << missesBefore / triangles << " -> "
+            << missesAfter / triangles << std::endl;
+    }
+}
+
+bool Application::update(float deltaTime)
+{
+    PROFILE_SCOPE("Update");
+
+    {
+        PROFILE_SCOPE("Input");
+
+        //poll IO events (keys pressed/released, mouse moved etc.)
+        glfwPollEvents();
+
+        //Live or replayed, from here on both drive the camera and the toggles the same way
+        deltaTime = nextInput(deltaTime);
+
+        //Benchmarks follow their camera path unless they replay a recording. The camera moves per
+        //frame rather than per step, fixed steps would add up to a step of input latency
+        if (_benchmark.IsEnabled() && !_inputPlayer.IsOpen()) {
+            _benchmark.UpdateCamera(_camera);
+        }
+        else {
+            handleInput(_input);
+        }
+
+        //Callbacks of the next poll collect into a fresh frame
+        _input.Presses.clear();
+        _input.Scroll = 0.f;
+    }
+
+    auto objectsChanged = false;
+    {
+        PROFILE_SCOPE("Simulation");
+
+        //Fixed steps whatever the frame time, animation looks the same at 30 and 144 fps and replays
+        //of the same input step the same way
+        _unsimulatedTime = std::min(_unsimulatedTime + deltaTime, static_cast<double>(MaxStepsPerFrame * SimulationStep));
+        while (_unsimulatedTime >= SimulationStep) {
+            objectsChanged |= simulate(SimulationStep);
+            _unsimulatedTime -= SimulationStep;
+        }
+    }
+
+    //Drawn the leftover fraction of a step behind the simulation, between its last two steps,
+    //so motion stays smooth when frames and steps don't line up
+    auto sceneChanged = _scene.Update(static_cast<float>(_unsimulatedTime / SimulationStep), _jobs);
+    _animating = objectsChanged || sceneChanged;
+
+    return false;
+}
+
+bool Application::simulate(float step) {
+    PROFILE_SCOPE("Step");
+
+    //objects update per step, spread over the job system workers
+    std::atomic<bool> changed{ false };
+    _jobs.ParallelFor(0, static_cast<uint32_t>(_objects.size()), 1, [this, step, &changed](uint32_t first, uint32_t last) {
+        for (auto i = first; i < last; i++) {
+            if (_objects[i]->Update(step)) {
+                changed.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    _scene.Step(step, _jobs);
+
+    return changed.load(std::memory_order_relaxed);
+}
+
+bool Application::waitWhileIdle() {
+    if (!_launchOptions.OnDemand || _benchmark.IsEnabled() || _inputPlayer.IsOpen() || !_running) {
+        return false;
+    }
+
+    //Input this frame, held movement keys, animation and running captures all need the next frame right away.
+    //Nothing to show while minimized though
+    auto changing = _redrawRequested || _animating || _input.MoveKeys != 0 || !_captureDirectory.empty() || Profiler::IsRecording();
+    _redrawRequested = false;
+    if (changing && !glfwGetWindowAttrib(_window, GLFW_ICONIFIED)) {
+        return false;
+    }
+
+    PROFILE_SCOPE("Idle");
+
+    //The window keeps showing the last frame. Callbacks run inside the wait and request the next one,
+    //a visible HUD is redrawn every timeout since its numbers keep changing
+    while (_running && !_redrawRequested && !glfwWindowShouldClose(_window)) {
+        glfwWaitEventsTimeout(IdleTimeout);
+
+        if (_hud.IsVisible() && !glfwGetWindowAttrib(_window, GLFW_ICONIFIED)) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool Application::draw()
+{
+    PROFILE_SCOPE("Draw");
+
+    //Waits while the render thread still reads this slot
+    auto& frame = _renderThread.BeginFrame();
+
+    frame.Width = _width;
+    frame.Height = _height;
+    //BG COLOR 
+    frame.ClearColor = { 0.2f, 0.196f, 0.184f, 1.0f };
+    frame.SwapInterval = _swapInterval;
+    frame.GpuBudgetMilliseconds = _gpuBudget;
+    frame.UpscaleSharpness = _launchOptions.UpscaleSharpness;
+
+    // Get Camera View Matrix
+    glm::mat4 view = _camera.GetViewMatrix();
+    // Get Camera Projection Matrix
+    glm::mat4 projection = _camera.GetProjectionMatrix(); 
+
+    frame.SceneParams = {
+        .ProjectionMatrix = projection,
+        .ViewMatrix = view,
+        .CameraPosition = _camera.GetPosition(),
+        .DirLight = {
+            .Direction = glm::normalize(glm::vec3{-0.2f, -0.5f, 1.f}),
+            .AmbientColor = {0.1f, 0.2f, 0.05f},
+            .DiffuseColor = {1.f, 0.9f, 0.9f},
+            .SpecularColor = {1.f, 0.9f, 0.9f}
+        }
+    };
+    
+    //The render thread keeps the materials between frames, only send them after a change
+    frame.MaterialsChanged = _materials.GetVersion() != _sentMaterialVersion;
+    if (frame.MaterialsChanged) {
+        frame.Materials = _materials.GetMaterials();
+        _sentMaterialVersion = _materials.GetVersion();
+    }
+
+    {
+        PROFILE_SCOPE("Lighting");
+
+        //Process lighting for all models
+        _scene.GatherLights(frame);
+
+        for (auto& model : _objects) {
+            model->ProcessLighting(frame.SceneParams);
+        }
+    }
+
+    //Culling, then lights for what survived it, as dependent jobs. The main thread collects the
+    //GPU scene and procedural changes meanwhile, neither touches what the jobs write
+    JobCounter culled;
+    JobCounter lightsAssigned;
+
+    _jobs.Run([this, viewProjection = projection * view]() {
+        PROFILE_SCOPE("Culling");
+
+        //Skip objects hidden behind the big occluders
+        cullOccludedObjects(viewProjection);
+    }, &culled);
+
+    _jobs.Run([this]() {
+        PROFILE_SCOPE("Assign lights");
+
+        //Only does work when there are more scene lights than shader slots
+        _scene.AssignLights(_visibleRenderables, _jobs);
+        _staticBatcher.AssignLights(_scene, _batchVisible);
+    }, &lightsAssigned, &culled);
+
+    //Scene renderables are culled and drawn on the GPU instead of going through packets
+    gatherGpuScene(frame.GpuScene);
+
+    //Procedural primitives only cost an instance record, resend the list when one was added, removed or moved
+    frame.Procedural.Changed = _scene.Procedurals.Version != _sentProceduralVersion;
+    if (frame.Procedural.Changed) {
+        _scene.GatherProceduralInstances(frame.Procedural.Instances);
+        _sentProceduralVersion = _scene.Procedurals.Version;
+    }
+
+    {
+        PROFILE_SCOPE("Wait for culling");
+
+        //Runs the chain's jobs here too. Lights start after culling finished, so both are done then
+        _jobs.Wait(lightsAssigned);
+    }
+
+    {
+        PROFILE_SCOPE("Gather packets");
+
+        //Gather: every worker writes packets into its own buffer, no locks and no GL calls
+        _packetBuilder.Begin(_jobs);
+
+        _jobs.ParallelFor(0, static_cast<uint32_t>(_objects.size()), 1, [this](uint32_t first, uint32_t last) {
+            auto& packets = _packetBuilder.GetBuffer(_jobs.GetThreadIndex());
+            for (auto i = first; i < last; i++) {
+                if (_objectVisible[i] && !_objects[i]->IsStatic) {
+                    auto firstPacket = packets.size();
+                    _objects[i]->GatherDrawPackets(packets);
+
+                    //Objects aren't renderables, they pick their lights here from their own bounds
+                    if (_scene.HasPerPacketLights()) {
+                        LightSet lights;
+                        _scene.SelectLights(_objects[i]->GetWorldBounds(), lights);
+                        for (auto packet = firstPacket; packet < packets.size(); packet++) {
+                            packets[packet].Lights = lights;
+                        }
+                    }
+                }
+            }
+        });
+
+        //A handful of packets, the calling thread's buffer is enough
+        _staticBatcher.GatherDrawPackets(_batchVisible, _packetBuilder.GetBuffer(_jobs.GetThreadIndex()));
+
+        _jobs.ParallelFor(0, static_cast<uint32_t>(_visibleRenderables.size()), 256, [this](uint32_t first, uint32_t last) {
+            _scene.GatherDrawPackets(_visibleRenderables, first, last, _packetBuilder.GetBuffer(_jobs.GetThreadIndex()));
+        });
+    }
+
+    {
+        PROFILE_SCOPE("Merge packets");
+
+        //Merge in state order, the render thread then only submits
+        _packetBuilder.Merge(_jobs, _materials, frame.Packets);
+
+        //The pre-pass has a single program, it draws front to back instead
+        frame.DepthPrepass = _depthPrepass;
+        frame.DepthOrder.clear();
+        if (_depthPrepass) {
+            _packetBuilder.SortFrontToBack(frame.Packets, _camera.GetPosition(), frame.DepthOrder);
+        }
+    }
+
+    //Timings and render counters are from the previous frame, this one isn't finished yet
+    _hud.Build(collectHudStats(), frame.Hud);
+
+    //The render thread reads the frame back once drawn, the image is written a few frames later
+    frame.CapturePath.clear();
+    if (_screenshotRequested) {
+        frame.CapturePath = std::filesystem::current_path() / "screenshots" / ("screenshot_" + captureTimestamp() + ".png");
+        std::cerr << "screenshot " << frame.CapturePath << std::endl;
+        _screenshotRequested = false;
+    }
+    else if (!_captureDirectory.empty()) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%05u.tga", _capturedFrames++);
+        frame.CapturePath = _captureDirectory / name;
+    }
+
+    _renderThread.SubmitFrame();
+
+    return false;
+}
+
+void Application::cullOccludedObjects(const glm::mat4& viewProjection) {
+    _objectVisible.assign(_objects.size(), true);
+    _batchVisible.assign(_staticBatcher.GetBatches().size(), true);
+    //GPU driven frames cull the scene renderables in gpu_cull.comp, nothing to gather here
+    _visibleRenderables.clear();
+
+    if (!_occlusionCullingEnabled) {
+        if (!_gpuDrivenEnabled) {
+            _scene.GatherVisible(nullptr, _visibleRenderables, _jobs);
+        }
+        return;
+    }
+
+    _occlusionCuller.BeginFrame(viewProjection);
+
+    for (auto& object : _objects) {
+        if (!object->IsOccluder) {
+            continue;
+        }
+
+        for (const auto& model : object->GetModels()) {
+            const auto* mesh = model.GetMesh();
+            _occlusionCuller.AddOccluder(object->Transform * mesh->Transform, mesh->GetBounds());
+        }
+    }
+
+    _occlusionCuller.RasterizeOccluders(_jobs);
+
+    //Occluders are always drawn, they'd only be tested against themselves
+    _jobs.ParallelFor(0, static_cast<uint32_t>(_objects.size()), 1, [this](uint32_t first, uint32_t last) {
+        for (auto i = first; i < last; i++) {
+            if (!_objects[i]->IsOccluder) {
+                _objectVisible[i] = _occlusionCuller.IsVisible(_objects[i]->GetWorldBounds());
+            }
+        }
+    });
+
+    //Merged bounds are larger than a single object's, so a batch is culled only when all of it is hidden
+    const auto& batches = _staticBatcher.GetBatches();
+    for (uint32_t i = 0; i < batches.size(); i++) {
+        _batchVisible[i] = _occlusionCuller.IsVisible(batches[i].Bounds);
+    }
+
+    if (!_gpuDrivenEnabled) {
+        _scene.GatherVisible(&_occlusionCuller, _visibleRenderables, _jobs);
+    }
+}
+
+void Application::gatherGpuScene(GpuSceneUpdate& update) {
+    update.Enabled = _gpuDrivenEnabled;
+    update.Rebuild = false;
+    update.Slots.clear();
+    update.Objects.clear();
+
+    if (!_gpuDrivenEnabled) {
+        //The render thread keeps stale data, resend everything when switched back on
+        _gpuSceneSent = false;
+        return;
+    }
+
+    //Rows moved or changed count: the whole list, otherwise only what moved since the last frame
+    if (!_gpuSceneSent || _gpuLayoutVersion != _scene.Renderables.LayoutVersion) {
+        update.Rebuild = true;
+        for (uint32_t row = 0; row < _scene.Renderables.Size(); row++) {
+            update.Objects.push_back(_scene.GetGpuObject(row));
+        }
+
+        _gpuSceneSent = true;
+        _gpuLayoutVersion = _scene.Renderables.LayoutVersion;
+        return;
+    }
+
+    for (auto row : _scene.GetChangedRenderables()) {
+        update.Slots.push_back(row);
+        update.Objects.push_back(_scene.GetGpuObject(row));
+    }
+}
+
+HudStats Application::collectHudStats() {
+    if (!_hud.IsVisible()) {
+        return {};
+    }
+
+    const auto& batches = _staticBatcher.GetBatches();
+    auto countVisible = [](const std::vector<uint8_t>& visible) {
+        return static_cast<uint32_t>(std::count(visible.begin(), visible.end(), uint8_t{ 1 }));
+    };
+
+    return {
+        .UpdateMilliseconds = _updateMilliseconds,
+        .DrawMilliseconds = _drawMilliseconds,
+        .Render = _renderThread.GetRenderStats(),
+        .TextureBytes = GpuMemory::GetTotal(GpuMemory::Kind::Texture),
+        .BufferBytes = GpuMemory::GetTotal(GpuMemory::Kind::Buffer),
+        .VisibleObjects = countVisible(_objectVisible),
+        .Objects = static_cast<uint32_t>(_objects.size()),
+        .VisibleBatches = countVisible(_batchVisible),
+        .Batches = static_cast<uint32_t>(batches.size()),
+        .VisibleRenderables = static_cast<uint32_t>(_visibleRenderables.size()),
+        .Renderables = static_cast<uint32_t>(_scene.Renderables.Size()),
+        .Procedurals = static_cast<uint32_t>(_scene.Procedurals.Size()),
+        .OcclusionCulling = _occlusionCullingEnabled,
+        .GpuCulling = _gpuDrivenEnabled,
+        .DepthPrepass = _depthPrepass
+    };
+}
+
+float Application::nextInput(float deltaTime) {
+    if (_inputPlayer.IsOpen()) {
+        //Live presses and scrolling are dropped, the recorded ones replace them
+        if (!_inputPlayer.Next(_input)) {
+            return deltaTime;
+        }
+
+        //Fixed step replays move the camera by the same amounts whatever the recording's frame rate was
+        if (_benchmark.IsEnabled() || _launchOptions.FixedStep) {
+            _input.DeltaTime = Benchmark::FrameDelta;
+        }
+    }
+    else {
+        _input.DeltaTime = deltaTime;
+        _input.MoveKeys = 0;
+        for (uint32_t i = 0; i < MoveKeys.size(); i++) {
+            if (glfwGetKey(_window, MoveKeys[i].Key)) {
+                _input.MoveKeys |= 1 << i;
+            }
+        }
+
+        glfwGetCursorPos(_window, &_input.Cursor.x, &_input.Cursor.y);
+    }
+
+    _inputRecorder.Write(_input);
+
+    return _input.DeltaTime;
+}
+
+void Application::handleInput(const InputFrame& input) {
+    for (auto key : input.Presses) {
+        handleKeyPress(key);
+    }
+
+    if (input.Scroll != 0.f) {
+        _camera.IncrementZoom(input.Scroll * 2);
+    }
+
+    //contols frame redraw rate affected computer processing power
+    auto moveAmount = _moveSpeed * input.DeltaTime;
+
+    for (uint32_t i = 0; i < MoveKeys.size(); i++) {
+        if (input.MoveKeys & (1 << i)) {
+            _camera.MoveCamera(MoveKeys[i].Direction, moveAmount);
+        }
+    }
+
+    mousePositionCallback(input.Cursor.x, input.Cursor.y);
+}
+
+void Application::handleKeyPress(int key) {
+    switch (key) {
+        case GLFW_KEY_P: {
+            _camera.SetIsPerspective(!_camera.isPerspective());
+            break;
+        }
+        case GLFW_KEY_O: {
+            _occlusionCullingEnabled = !_occlusionCullingEnabled;
+            std::cerr << "occlusion culling " << (_occlusionCullingEnabled ? "on" : "off") << std::endl;
+            break;
+        }
+        case GLFW_KEY_G: {
+            _gpuDrivenEnabled = !_gpuDrivenEnabled;
+            std::cerr << "gpu driven scene " << (_gpuDrivenEnabled ? "on" : "off") << std::endl;
+            break;
+        }
+        case GLFW_KEY_H: {
+            _hud.Toggle();
+            break;
+        }
+        case GLFW_KEY_T: {
+            Profiler::BeginCapture(120, std::filesystem::current_path() / "profile_trace.json");
+            break;
+        }
+        case GLFW_KEY_L: {
+            GlTrace::BeginCapture(120, std::filesystem::current_path() / "gl_trace.txt");
+            break;
+        }
+        case GLFW_KEY_V: {
+            _swapInterval = _swapInterval == 0 ? std::max(1, static_cast<int>(_launchOptions.SwapInterval)) : 0;
+            std::cerr << "vsync " << (_swapInterval != 0 ? "on" : "off") << std::endl;
+            break;
+        }
+        case GLFW_KEY_R: {
+            auto budget = _launchOptions.GpuBudgetMilliseconds > 0.f ? _launchOptions.GpuBudgetMilliseconds : DefaultGpuBudget;
+            _gpuBudget = _gpuBudget > 0.f ? 0.f : budget;
+            std::cerr << "dynamic resolution " << (_gpuBudget > 0.f ? "on" : "off") << std::endl;
+            break;
+        }
+        case GLFW_KEY_Z: {
+            _depthPrepass = !_depthPrepass;
+            std::cerr << "depth pre-pass " << (_depthPrepass ? "on" : "off") << std::endl;
+            break;
+        }
+        case GLFW_KEY_F12: {
+            _screenshotRequested = true;
+            break;
+        }
+        case GLFW_KEY_F11: {
+            if (_captureDirectory.empty()) {
+                _captureDirectory = std::filesystem::current_path() / "captures" / ("sequence_" + captureTimestamp());
+                _capturedFrames = 0;
+                std::cerr << "capturing frames to " << _captureDirectory << std::endl;
+            }
+            else {
+                std::cerr << "captured " << _capturedFrames << " frames" << std::endl;
+                _captureDirectory.clear();
+            }
+            break;
+        }
+        default: {}
+    }
+}
+
+void Application::mousePositionCallback(double xpos, double ypos) {
+    if (!_firstMouse) {
+        _lastMousePosition.x = static_cast<float>(xpos);
+        _lastMousePosition.y = static_cast<float>(ypos);
+
+        _firstMouse = true;
+    };
+
+    glm::vec2 moveAmount{
+        xpos - _lastMousePosition.x,
+        _lastMousePosition.y - ypos
+    };
+
+    _lastMousePosition.x = static_cast<float>(xpos);
+    _lastMousePosition.y = static_cast<float>(ypos);
+
+    _camera.RotateBy(moveAmount.x * _cameraLookSpeed.x, moveAmount.y * _cameraLookSpeed.y);
+}
+
+
+
+
@@ -0,0 +1,125 @@
+#include <core/benchmark.h>
+#include <rendering/gpu_memory.h>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+namespace {
+	void writeStats(std::ostream& out, const char* name, std::vector<double> samples) {
+		out << "\"" << name << "\":{";
+		if (samples.empty()) {
+			out << "}";
+			return;
+		}
+
+		auto percentile = [&samples](double fraction) {
+			auto index = std::min(samples.size() - 1, static_cast<size_t>(fraction * samples.size()));
+			std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+			return samples[index];
+		};
+
+		auto mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+		auto max = *std::max_element(samples.begin(), samples.end());
+
+		out << "\"mean\":" << mean << ",\"p50\":" << percentile(0.5) << ",\"p95\":" << percentile(0.95)
+			<< ",\"p99\":" << percentile(0.99) << ",\"max\":" << max << "}";
+	}
+}
+
+Benchmark::Benchmark(const BenchmarkOptions& options)
+	: _options{ options } {
+	if (_options.Enabled) {
+		_frameTimes.reserve(_options.Frames);
+		_updateTimes.reserve(_options.Frames);
+		_drawTimes.reserve(_options.Frames);
+		_submitTimes.reserve(_options.Frames);
+		_gpuTimes.reserve(_options.Frames);
+	}
+}
+
+void Benchmark::UpdateCamera(Camera& camera) const {
+	//One orbit around the desk over the whole run, swinging in and out and up and down so the
+	//occluders hide different objects along the way
+	auto progress = static_cast<float>(_frame) / static_cast<float>(_options.WarmupFrames + _options.Frames);
+	auto angle = progress * glm::two_pi<float>();
+
+	auto distance = 3.f + 0.75f * std::sin(angle * 3.f);
+	auto height = 0.5f + 0.5f * std::sin(angle * 2.f);
+	glm::vec3 target{ 0.f, -0.6f, 0.25f };
+
+	camera.LookAt(target + glm::vec3{ distance * std::sin(angle), height, distance * std::cos(angle) }, target);
+}
+
+void Benchmark::AddFrame(double frameMilliseconds, double updateMilliseconds, double drawMilliseconds, const RenderStats& stats) {
+	auto frame = _frame++;
+	if (frame < _options.WarmupFrames || frame >= _options.WarmupFrames + _options.Frames) {
+		return;
+	}
+
+	_frameTimes.push_back(frameMilliseconds);
+	_updateTimes.push_back(updateMilliseconds);
+	_drawTimes.push_back(drawMilliseconds);
+	_submitTimes.push_back(stats.SubmitMilliseconds);
+	_gpuTimes.push_back(stats.GpuMilliseconds);
+
+	_drawCalls += stats.DrawCalls;
+	_triangles += stats.Triangles;
+	_programBinds += stats.ProgramBinds;
+	_textureBinds += stats.TextureBinds;
+	_renderScale += stats.RenderScale;
+}
+
+bool Benchmark::Report(const StreamBufferStats& streamStats) const {
+	if (_options.Output.empty()) {
+		writeJson(std::cout, streamStats);
+		return true;
+	}
+
+	std::ofstream out(_options.Output);
+	if (!out) {
+		std::cerr << "Benchmark: could not open " << _options.Output << std::endl;
+		return false;
+	}
+
+	writeJson(out, streamStats);
+	std::cerr << "benchmark: wrote " << _options.Output << std::endl;
+
+	return static_cast<bool>(out);
+}
+
+void Benchmark::writeJson(std::ostream& out, const StreamBufferStats& streamStats) const {
+	auto frames = std::max<size_t>(_frameTimes.size(), 1);
+	auto perFrame = [frames](uint64_t total) { return static_cast<double>(total) / frames; };
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\"frames\":" << _frameTimes.size() << ",\"warmup\":" << _options.WarmupFrames
+		<< ",\"width\":" << _options.Width << ",\"height\":" << _options.Height << ",\n";
+
+	out << "\"milliseconds\":{";
+	writeStats(out, "frame", _frameTimes);
+	out << ",";
+	writeStats(out, "update", _updateTimes);
+	out << ",";
+	writeStats(out, "draw", _drawTimes);
+	out << ",";
+	writeStats(out, "submit", _submitTimes);
+	out << ",";
+	writeStats(out, "gpu", _gpuTimes);
+	out << "},\n";
+
+	out << "\"per_frame\":{\"draw_calls\":" << perFrame(_drawCalls) << ",\"triangles\":" << perFrame(_triangles)
+		<< ",\"program_binds\":" << perFrame(_programBinds) << ",\"texture_binds\":" << perFrame(_textureBinds)
+		<< ",\"render_scale\":" << _renderScale / frames << "},\n";
+
+	out << "\"stream_buffer\":{\"waits\":" << streamStats.Waits << ",\"wait_milliseconds\":" << streamStats.WaitMilliseconds
+		<< ",\"reallocations\":" << streamStats.Reallocations << "},\n";
+
+	out << "\"gpu_memory\":{\"buffer_bytes\":" << GpuMemory::GetTotal(GpuMemory::Kind::Buffer)
+		<< ",\"texture_bytes\":" << GpuMemory::GetTotal(GpuMemory::Kind::Texture)
+		<< ",\"renderbuffer_bytes\":" << GpuMemory::GetTotal(GpuMemory::Kind::Renderbuffer) << "}}" << std::endl;
+
+	out << std::defaultfloat;
+}
@@ -0,0 +1,65 @@
+#include <core/frame_pacer.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+	//Later slices weigh at least 1/MaxSleepSamples, the estimate follows a changing system timer
+	constexpr uint32_t MaxSleepSamples = 1000;
+}
+
+void FramePacer::SetTargetRate(double framesPerSecond) {
+	_targetRate = std::max(framesPerSecond, 0.);
+	_period = _targetRate > 0.
+		? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1. / _targetRate))
+		: Clock::duration{ 0 };
+	_frameStart = {};
+}
+
+void FramePacer::Wait() {
+	if (_period == Clock::duration{ 0 }) {
+		return;
+	}
+
+	PROFILE_SCOPE("Frame pacing");
+
+	auto now = Clock::now();
+	auto nextFrame = _frameStart + _period;
+
+	//Slots stay on a fixed grid so small overshoots don't add up. More than a frame behind (first
+	//frame, a hitch) starts a new grid instead of rushing out frames to catch up
+	if (_frameStart == Clock::time_point{} || now > nextFrame + _period) {
+		_frameStart = now;
+		return;
+	}
+
+	_frameStart = nextFrame;
+	if (now < nextFrame) {
+		sleepUntil(nextFrame);
+	}
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline) {
+	auto remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+
+	//Sleep while even a slow slice ends before the deadline
+	while (remaining > _sleepMean + std::sqrt(_sleepVariance)) {
+		auto start = Clock::now();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		auto slept = std::chrono::duration<double>(Clock::now() - start).count();
+		remaining -= slept;
+
+		//Running average over the samples so far, or the latest MaxSleepSamples
+		_sleepSamples = std::min(_sleepSamples + 1, MaxSleepSamples);
+		auto weight = 1. / _sleepSamples;
+		auto delta = slept - _sleepMean;
+		_sleepMean += weight * delta;
+		_sleepVariance = (1. - weight) * (_sleepVariance + weight * delta * delta);
+	}
+
+	//Spin the rest, well under a millisecond with a fine system timer
+	while (Clock::now() < deadline) {
+		std::this_thread::yield();
+	}
+}
@@ -0,0 +1,109 @@
+#include <core/input_log.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+	constexpr char Magic[4] = { 'C', 'S', 'I', 'N' };
+	constexpr uint32_t Version = 1;
+
+	template <typename T>
+	void write(std::ofstream& out, const T& value) {
+		out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	template <typename T>
+	bool read(std::ifstream& in, T& value) {
+		return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+	}
+}
+
+bool InputRecorder::Open(const std::filesystem::path& path) {
+	_out.open(path, std::ios::binary | std::ios::trunc);
+	if (!_out) {
+		std::cerr << "InputRecorder: could not open " << path << std::endl;
+		return false;
+	}
+
+	_out.write(Magic, sizeof(Magic));
+	write(_out, Version);
+
+	std::cerr << "input: recording to " << path << std::endl;
+	return true;
+}
+
+void InputRecorder::Write(const InputFrame& frame) {
+	if (!IsOpen()) {
+		return;
+	}
+
+	write(_out, frame.DeltaTime);
+	write(_out, frame.Scroll);
+	write(_out, frame.Cursor.x);
+	write(_out, frame.Cursor.y);
+	write(_out, frame.MoveKeys);
+
+	//More presses than fit in a frame's count are dropped, nobody types 255 keys in one frame
+	auto pressCount = static_cast<uint8_t>(std::min<size_t>(frame.Presses.size(), UINT8_MAX));
+	write(_out, pressCount);
+	for (uint8_t i = 0; i < pressCount; i++) {
+		write(_out, frame.Presses[i]);
+	}
+}
+
+bool InputPlayer::Load(const std::filesystem::path& path) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		std::cerr << "InputPlayer: could not open " << path << std::endl;
+		return false;
+	}
+
+	char magic[sizeof(Magic)]{};
+	uint32_t version = 0;
+	in.read(magic, sizeof(magic));
+	if (!read(in, version) || std::memcmp(magic, Magic, sizeof(Magic)) != 0 || version != Version) {
+		std::cerr << "InputPlayer: " << path << " is not an input log of this version" << std::endl;
+		return false;
+	}
+
+	_frames.clear();
+	_nextFrame = 0;
+
+	//A recording cut short by a crash ends in a partial frame, which is dropped
+	while (true) {
+		InputFrame frame{};
+		uint8_t pressCount = 0;
+		if (!read(in, frame.DeltaTime) || !read(in, frame.Scroll) || !read(in, frame.Cursor.x) || !read(in, frame.Cursor.y) ||
+			!read(in, frame.MoveKeys) || !read(in, pressCount)) {
+			break;
+		}
+
+		frame.Presses.resize(pressCount);
+		auto complete = true;
+		for (auto& press : frame.Presses) {
+			complete = complete && read(in, press);
+		}
+
+		if (!complete) {
+			break;
+		}
+		_frames.push_back(std::move(frame));
+	}
+
+	if (_frames.empty()) {
+		std::cerr << "InputPlayer: " << path << " has no frames" << std::endl;
+		return false;
+	}
+
+	std::cerr << "input: replaying " << _frames.size() << " frames from " << path << std::endl;
+	return true;
+}
+
+bool InputPlayer::Next(InputFrame& frame) {
+	if (_nextFrame == _frames.size()) {
+		return false;
+	}
+
+	frame = _frames[_nextFrame++];
+	return true;
+}
@@ -0,0 +1,186 @@
+#include <core/job_system.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <string>
+
+namespace {
+	//Which system and queue the current thread works for, threads outside the system use queue 0
+	thread_local const JobSystem* currentSystem = nullptr;
+	thread_local uint32_t currentQueueIndex = 0;
+}
+
+JobSystem::JobSystem(uint32_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for (uint32_t i = 0; i < threadCount; i++) {
+		_queues.emplace_back(std::make_unique<WorkQueue>());
+	}
+
+	for (uint32_t i = 1; i < threadCount; i++) {
+		_workers.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard lock(_sleepMutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+
+	for (auto& worker : _workers) {
+		worker.join();
+	}
+}
+
+void JobSystem::Run(Job job, JobCounter* counter, JobCounter* dependency) {
+	if (counter) {
+		counter->_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Job wrapped = [this, job = std::move(job), counter]() {
+		{
+			PROFILE_SCOPE("Job");
+			job();
+		}
+		if (counter) {
+			finish(*counter);
+		}
+	};
+
+	if (dependency) {
+		std::lock_guard lock(dependency->_mutex);
+		if (!dependency->IsDone()) {
+			dependency->_continuations.emplace_back(std::move(wrapped));
+			return;
+		}
+	}
+
+	push(std::move(wrapped));
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+	while (!counter.IsDone()) {
+		Job job;
+		if (tryPop(job)) {
+			job();
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	//The last finisher may still hold the lock while handing off continuations
+	std::lock_guard lock(counter._mutex);
+}
+
+void JobSystem::ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const std::function<void(uint32_t first, uint32_t last)>& function) {
+	if (end <= begin) {
+		return;
+	}
+
+	auto count = end - begin;
+	grainSize = std::max(grainSize, 1u);
+
+	//A few chunks per thread so stealing can even out uneven chunks
+	auto chunkCount = std::min((count + grainSize - 1) / grainSize, GetThreadCount() * 4);
+	if (chunkCount <= 1) {
+		function(begin, end);
+		return;
+	}
+
+	auto chunkSize = (count + chunkCount - 1) / chunkCount;
+
+	JobCounter counter;
+	for (auto first = begin + chunkSize; first < end; first += chunkSize) {
+		auto last = std::min(first + chunkSize, end);
+		Run([&function, first, last]() { function(first, last); }, &counter);
+	}
+
+	function(begin, std::min(begin + chunkSize, end));
+	Wait(counter);
+}
+
+void JobSystem::push(Job job) {
+	auto& queue = *_queues[GetThreadIndex()];
+	{
+		std::lock_guard lock(queue.Mutex);
+		queue.Jobs.emplace_back(std::move(job));
+	}
+
+	{
+		std::lock_guard lock(_sleepMutex);
+		_queuedJobs.fetch_add(1, std::memory_order_release);
+	}
+	_wake.notify_one();
+}
+
+bool JobSystem::tryPop(Job& job) {
+	auto own = GetThreadIndex();
+	auto queueCount = static_cast<uint32_t>(_queues.size());
+
+	//Own queue from the back (most recent, still in cache), then steal the oldest job of the others
+	for (uint32_t i = 0; i < queueCount; i++) {
+		auto& queue = *_queues[(own + i) % queueCount];
+
+		std::lock_guard lock(queue.Mutex);
+		if (queue.Jobs.empty()) {
+			continue;
+		}
+
+		if (i == 0) {
+			job = std::move(queue.Jobs.back());
+			queue.Jobs.pop_back();
+		}
+		else {
+			job = std::move(queue.Jobs.front());
+			queue.Jobs.pop_front();
+		}
+
+		_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	return false;
+}
+
+void JobSystem::finish(JobCounter& counter) {
+	std::vector<Job> continuations;
+	{
+		std::lock_guard lock(counter._mutex);
+		if (counter._count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			continuations.swap(counter._continuations);
+		}
+	}
+
+	for (auto& continuation : continuations) {
+		push(std::move(continuation));
+	}
+}
+
+void JobSystem::workerLoop(uint32_t queueIndex) {
+	PROFILE_THREAD("Worker " + std::to_string(queueIndex));
+	currentSystem = this;
+	currentQueueIndex = queueIndex;
+
+	while (true) {
+		Job job;
+		if (tryPop(job)) {
+			job();
+			continue;
+		}
+
+		std::unique_lock lock(_sleepMutex);
+		_wake.wait(lock, [this]() { return _stopping || _queuedJobs.load(std::memory_order_acquire) > 0; });
+
+		if (_stopping) {
+			return;
+		}
+	}
+}
+
+uint32_t JobSystem::GetThreadIndex() const {
+	return currentSystem == this ? currentQueueIndex : 0;
+}
@@ -0,0 +1,102 @@
+#include <core/launch_options.h>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+	bool parseCount(const char* text, uint32_t& value) {
+		char* end = nullptr;
+		auto parsed = std::strtoul(text, &end, 10);
+		if (end == text || *end != '\0') {
+			return false;
+		}
+
+		value = static_cast<uint32_t>(parsed);
+		return true;
+	}
+
+	bool parseNumber(const char* text, float& value) {
+		char* end = nullptr;
+		auto parsed = std::strtof(text, &end);
+		if (end == text || *end != '\0' || parsed < 0.f) {
+			return false;
+		}
+
+		value = parsed;
+		return true;
+	}
+}
+
+bool ParseLaunchOptions(int argc, char* argv[], LaunchOptions& options) {
+	auto& benchmark = options.Benchmark;
+
+	for (auto i = 1; i < argc; i++) {
+		auto argument = std::string(argv[i]);
+		auto hasValue = i + 1 < argc;
+
+		if (argument == "--benchmark") {
+			benchmark.Enabled = true;
+		}
+		else if (argument == "--frames" && hasValue && parseCount(argv[i + 1], benchmark.Frames) && benchmark.Frames > 0) {
+			i++;
+		}
+		else if (argument == "--warmup" && hasValue && parseCount(argv[i + 1], benchmark.WarmupFrames)) {
+			i++;
+		}
+		else if (argument == "--size" && hasValue && std::sscanf(argv[i + 1], "%dx%d", &benchmark.Width, &benchmark.Height) == 2 &&
+			benchmark.Width > 0 && benchmark.Height > 0) {
+			i++;
+		}
+		else if (argument == "--output" && hasValue) {
+			benchmark.Output = argv[++i];
+		}
+		else if (argument == "--record" && hasValue) {
+			options.RecordInput = argv[++i];
+		}
+		else if (argument == "--replay" && hasValue) {
+			options.ReplayInput = argv[++i];
+		}
+		else if (argument == "--fixed-step") {
+			options.FixedStep = true;
+		}
+		else if (argument == "--capture" && hasValue) {
+			options.CaptureDirectory = argv[++i];
+		}
+		else if (argument == "--swap-interval" && hasValue && parseCount(argv[i + 1], options.SwapInterval)) {
+			i++;
+		}
+		else if (argument == "--fps" && hasValue && parseCount(argv[i + 1], options.TargetFrameRate)) {
+			i++;
+		}
+		else if (argument == "--on-demand") {
+			options.OnDemand = true;
+		}
+		else if (argument == "--gpu-budget" && hasValue && parseNumber(argv[i + 1], options.GpuBudgetMilliseconds)) {
+			i++;
+		}
+		else if (argument == "--sharpness" && hasValue && parseNumber(argv[i + 1], options.UpscaleSharpness) && options.UpscaleSharpness <= 1.f) {
+			i++;
+		}
+		else if (argument == "--depth-prepass") {
+			options.DepthPrepass = true;
+		}
+		else if (argument == "--mesh-stats") {
+			options.MeshStats = true;
+		}
+		else {
+			std::cerr << "Unknown or malformed argument " << argument << std::endl;
+			std::cerr << "usage: CS330_Project [--benchmark [--frames N] [--warmup N] [--size WxH] [--output file]]"
+				<< " [--record file | --replay file] [--fixed-step] [--capture directory] [--swap-interval N] [--fps N] [--on-demand]"
+				<< " [--gpu-budget ms] [--sharpness 0..1] [--depth-prepass] [--mesh-stats]" << std::endl;
+			return false;
+		}
+	}
+
+	if (!options.RecordInput.empty() && !options.ReplayInput.empty()) {
+		std::cerr << "--record and --replay can't be combined" << std::endl;
+		return false;
+	}
+
+	return true;
+}
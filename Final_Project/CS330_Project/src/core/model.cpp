@@ -1,6 +1,6 @@
-#include <core/model.h>
-
-Model::Model(std::shared_ptr<Mesh> mesh, std::shared_ptr<Shader> shader) : 
-	_shader {shader},
-	_mesh {mesh}
-{}
+#include <core/model.h>
+
+Model::Model(std::shared_ptr<Mesh> mesh, MaterialId material) : 
+	_material {material},
+	_mesh {mesh}
+{}
@@ -0,0 +1,134 @@
+#include <core/performance_hud.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+//Static functions only, no implementation define needed
+#include <stb_easy_font.h>
+
+namespace {
+	constexpr float MARGIN = 4.f;
+	constexpr float LINE_HEIGHT = 10.f;
+	constexpr float GRAPH_HEIGHT = 40.f;
+	//Frame time at the top of the graph
+	constexpr float GRAPH_MAX_MILLISECONDS = 50.f;
+
+	constexpr uint8_t TEXT_COLOR[4] = { 230, 230, 230, 255 };
+	constexpr uint8_t PANEL_COLOR[4] = { 0, 0, 0, 160 };
+	constexpr uint8_t TARGET_COLOR[4] = { 255, 255, 255, 96 };
+	constexpr uint8_t FAST_COLOR[4] = { 80, 220, 80, 255 };
+	constexpr uint8_t SLOW_COLOR[4] = { 240, 200, 40, 255 };
+	constexpr uint8_t HITCH_COLOR[4] = { 240, 60, 60, 255 };
+
+	void addQuad(std::vector<HudVertex>& vertices, float x0, float y0, float x1, float y1, const uint8_t (&color)[4]) {
+		for (auto [x, y] : { std::pair{ x0, y0 }, std::pair{ x1, y0 }, std::pair{ x1, y1 }, std::pair{ x0, y1 } }) {
+			vertices.push_back({ .X = x, .Y = y, .Color = { color[0], color[1], color[2], color[3] } });
+		}
+	}
+
+	//Returns the width of the line
+	float addText(std::vector<HudVertex>& vertices, float x, float y, char* text) {
+		//stb_easy_font stays below 16 quads per character
+		auto first = vertices.size();
+		auto capacity = std::strlen(text) * 16 * 4;
+		vertices.resize(first + capacity);
+
+		auto color = TEXT_COLOR;
+		auto quads = stb_easy_font_print(x, y, text, const_cast<unsigned char*>(color), vertices.data() + first, static_cast<int>(capacity * sizeof(HudVertex)));
+		vertices.resize(first + quads * 4);
+
+		return static_cast<float>(stb_easy_font_width(text));
+	}
+
+	double megabytes(int64_t bytes) {
+		return static_cast<double>(bytes) / (1024.0 * 1024.0);
+	}
+}
+
+void PerformanceHud::AddFrameTime(double milliseconds) {
+	_frameTimes[_nextSample] = static_cast<float>(milliseconds);
+	_nextSample = (_nextSample + 1) % SampleCount;
+	_sampleCount = std::min(_sampleCount + 1, SampleCount);
+	_sinceTextRefresh += milliseconds;
+}
+
+void PerformanceHud::Build(const HudStats& stats, std::vector<HudVertex>& vertices) {
+	vertices.clear();
+	if (!_visible || _sampleCount == 0) {
+		//Shown again: lay the text out right away
+		_sinceTextRefresh = TextRefreshMilliseconds;
+		return;
+	}
+
+	//Oldest sample first
+	std::array<float, SampleCount> samples{};
+	for (uint32_t i = 0; i < _sampleCount; i++) {
+		samples[i] = _frameTimes[(_nextSample + SampleCount - _sampleCount + i) % SampleCount];
+	}
+
+	if (_sinceTextRefresh >= TextRefreshMilliseconds) {
+		auto sorted = samples;
+		auto percentile = [&sorted, this](float fraction) {
+			auto index = static_cast<uint32_t>(fraction * static_cast<float>(_sampleCount - 1) + 0.5f);
+			std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + _sampleCount);
+			return sorted[index];
+		};
+
+		auto p50 = percentile(0.5f);
+		auto p99 = percentile(0.99f);
+		buildText(stats, samples[_sampleCount - 1], p50, p99);
+		_sinceTextRefresh = 0.0;
+	}
+
+	auto width = std::max(_textWidth, static_cast<float>(SampleCount));
+	auto graphBottom = MARGIN + _textHeight + GRAPH_HEIGHT;
+
+	//Panel first so the text and graph blend over it
+	vertices.reserve(4 + _text.size() + (SampleCount + 1) * 4);
+	addQuad(vertices, 0.f, 0.f, MARGIN * 2.f + width, graphBottom + MARGIN, PANEL_COLOR);
+	vertices.insert(vertices.end(), _text.begin(), _text.end());
+
+	//One bar per frame, colored against 60 and 30 fps
+	for (uint32_t i = 0; i < _sampleCount; i++) {
+		auto milliseconds = samples[i];
+		auto height = std::min(milliseconds / GRAPH_MAX_MILLISECONDS, 1.f) * GRAPH_HEIGHT;
+		const auto& color = milliseconds <= 1000.f / 59.f ? FAST_COLOR : milliseconds <= 1000.f / 29.f ? SLOW_COLOR : HITCH_COLOR;
+
+		auto x = MARGIN + static_cast<float>(SampleCount - _sampleCount + i);
+		addQuad(vertices, x, graphBottom - height, x + 1.f, graphBottom, color);
+	}
+
+	auto targetY = graphBottom - 1000.f / 60.f / GRAPH_MAX_MILLISECONDS * GRAPH_HEIGHT;
+	addQuad(vertices, MARGIN, targetY, MARGIN + static_cast<float>(SampleCount), targetY + 0.5f, TARGET_COLOR);
+}
+
+void PerformanceHud::buildText(const HudStats& stats, float latest, float p50, float p99) {
+	char lines[6][128];
+	std::snprintf(lines[0], sizeof(lines[0]), "frame %6.2f ms  %5.0f fps   p50 %.2f  p99 %.2f ms",
+		latest, latest > 0.f ? 1000.f / latest : 0.f, p50, p99);
+	std::snprintf(lines[1], sizeof(lines[1]), "cpu   update %.2f  draw %.2f  submit %.2f ms   gpu %.2f ms at %.0f%%",
+		stats.UpdateMilliseconds, stats.DrawMilliseconds, stats.Render.SubmitMilliseconds, stats.Render.GpuMilliseconds, stats.Render.RenderScale * 100.f);
+	std::snprintf(lines[2], sizeof(lines[2]), "draws %u  triangles %llu  program binds %u  texture binds %u  depth pre-pass %s",
+		stats.Render.DrawCalls, static_cast<unsigned long long>(stats.Render.Triangles), stats.Render.ProgramBinds, stats.Render.TextureBinds,
+		stats.DepthPrepass ? "on" : "off");
+	std::snprintf(lines[3], sizeof(lines[3]), "memory textures %.1f MB  buffers %.1f MB",
+		megabytes(stats.TextureBytes), megabytes(stats.BufferBytes));
+	std::snprintf(lines[4], sizeof(lines[4]), "culling objects %u/%u  batches %u/%u  occlusion %s",
+		stats.VisibleObjects, stats.Objects, stats.VisibleBatches, stats.Batches, stats.OcclusionCulling ? "on" : "off");
+	if (stats.GpuCulling) {
+		std::snprintf(lines[5], sizeof(lines[5]), "scene %u on the GPU  procedural %u", stats.Renderables, stats.Procedurals);
+	}
+	else {
+		std::snprintf(lines[5], sizeof(lines[5]), "scene %u/%u  procedural %u", stats.VisibleRenderables, stats.Renderables, stats.Procedurals);
+	}
+
+	_text.clear();
+	_textWidth = 0.f;
+
+	auto y = MARGIN;
+	for (auto& line : lines) {
+		_textWidth = std::max(_textWidth, addText(_text, MARGIN, y, line));
+		y += LINE_HEIGHT;
+	}
+	_textHeight = y - MARGIN;
+}
@@ -0,0 +1,91 @@
+#include <core/prefabs.h>
+#include <core/shapes.h>
+
+void PrefabLibrary::Load(MaterialLibrary& materials) {
+	_litShader = std::make_shared<Shader>(Shader::ShaderPath / "basic_lit.vert", Shader::ShaderPath / "basic_lit.frag");
+	_unlitColorShader = std::make_shared<Shader>(Shader::ShaderPath / "basic_unlit_color.vert", Shader::ShaderPath / "basic_unlit_color.frag");
+
+	auto texturePath = std::filesystem::current_path() / "assets" / "textures";
+	_plastic1Texture = std::make_shared<Texture>(texturePath / "plastic1.jpg");
+	_plastic2Texture = std::make_shared<Texture>(texturePath / "plastic2.jpg");
+
+	static constexpr auto jar = Shapes::Cylinder<32>(0.25f, 0.75f);
+	_cubeMesh = std::make_shared<Mesh>(Shapes::Cube.Vertices, Shapes::Cube.Elements);
+	_jarMesh = std::make_shared<Mesh>(jar.Vertices, jar.Elements);
+
+	//Calculator: dark body with 4 procedural cylinder pins
+	_calculatorMaterial = materials.Add({ .Program = _litShader.get(), .Textures = { _plastic1Texture.get(), _plastic1Texture.get() }, .Color = { 0.2f, 0.2f, 0.2f } });
+
+	//Peanut jar: body and a red lid
+	_jarBodyMaterial = materials.Add({ .Program = _litShader.get(), .Textures = { _plastic2Texture.get(), _plastic2Texture.get() }, .Color = { 0.8f, 0.702f, 0.302f } });
+	_jarCoverMaterial = materials.Add({ .Program = _litShader.get(), .Textures = { _plastic2Texture.get(), _plastic2Texture.get() }, .Color = { 0.8f, 0.2f, 0.2f } });
+
+	_lightMaterial = materials.Add({ .Program = _unlitColorShader.get() });
+}
+
+Entity PrefabLibrary::SpawnCalculator(Scene& scene, const glm::vec3& position, const glm::quat& rotation) {
+	//Unscaled root so the body's non uniform scale doesn't leak into the pins
+	auto root = scene.CreateEntity();
+	scene.Transforms.Add(root, position, rotation, glm::vec3{ 1.f });
+
+	spawnPart(scene, root, { 0.f, 0.175f, 0.1f }, glm::quat{ 1.f, 0.f, 0.f, 0.f }, { 0.5f, 0.1f, 1.f },
+		_cubeMesh, _calculatorMaterial);
+
+	auto pinRotation = glm::angleAxis(glm::radians(-90.f), glm::vec3(1, 0, 0));
+	const glm::vec3 pinOffsets[] = {
+		{ -0.2f, 0.21f, 0.55f },
+		{ 0.2f, 0.21f, 0.55f },
+		{ -0.2f, 0.21f, -0.35f },
+		{ 0.2f, 0.21f, -0.35f }
+	};
+
+	for (const auto& pinOffset : pinOffsets) {
+		spawnProceduralPart(scene, root, pinOffset, pinRotation,
+			ProceduralShape::Cylinder, 32, { 0.025f, 0.05f }, _calculatorMaterial);
+	}
+
+	return root;
+}
+
+Entity PrefabLibrary::SpawnPeanutJar(Scene& scene, const glm::vec3& position, const glm::quat& rotation) {
+	auto body = spawnPart(scene, NullEntity, position, rotation, glm::vec3{ 1.f },
+		_jarMesh, _jarBodyMaterial);
+
+	//Lid follows the jar body
+	spawnPart(scene, body, { 0.f, 0.f, -0.35f }, glm::quat{ 1.f, 0.f, 0.f, 0.f }, { 1.25f, 1.15f, 0.25f },
+		_jarMesh, _jarCoverMaterial);
+
+	return body;
+}
+
+Entity PrefabLibrary::SpawnPointLight(Scene& scene, const glm::vec3& position, const PointLightStruct& light) {
+	auto entity = scene.CreateEntity();
+
+	scene.Transforms.Add(entity, position, glm::quat{ 1.f, 0.f, 0.f, 0.f }, glm::vec3{ 0.1f });
+	scene.Renderables.Add(entity, _cubeMesh.get(), _lightMaterial);
+	scene.PointLights.Add(entity, light);
+
+	return entity;
+}
+
+Entity PrefabLibrary::spawnPart(Scene& scene, Entity parent,
+	const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale,
+	const std::shared_ptr<Mesh>& mesh, MaterialId material) {
+	auto entity = scene.CreateEntity();
+
+	scene.Transforms.Add(entity, position, rotation, scale, parent);
+	scene.Renderables.Add(entity, mesh.get(), material);
+
+	return entity;
+}
+
+Entity PrefabLibrary::spawnProceduralPart(Scene& scene, Entity parent,
+	const glm::vec3& position, const glm::quat& rotation,
+	ProceduralShape shape, uint32_t sectors, const glm::vec2& size, MaterialId material) {
+	auto entity = scene.CreateEntity();
+
+	scene.Transforms.Add(entity, position, rotation, glm::vec3{ 1.f }, parent);
+	scene.Procedurals.Add(entity, shape, sectors, size, material);
+
+	return entity;
+}
@@ -0,0 +1,192 @@
+#include <core/profiler.h>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+	const auto startTime = std::chrono::steady_clock::now();
+
+	std::atomic<bool> recording{ false };
+	//Bumped per capture, tracks with an older generation are stale and skipped
+	std::atomic<uint64_t> generation{ 0 };
+
+	//Main thread only
+	uint32_t captureFramesLeft{ 0 };
+	std::filesystem::path capturePath{};
+
+	//Tracks live until exit, threads keep pointers to theirs
+	std::mutex tracksMutex;
+	std::vector<std::unique_ptr<ProfileTrack>> tracks;
+
+	thread_local ProfileTrack* threadTrack = nullptr;
+	thread_local uint32_t threadDepth = 0;
+
+	ProfileTrack& currentTrack() {
+		if (!threadTrack) {
+			std::lock_guard lock(tracksMutex);
+			auto& track = tracks.emplace_back(std::make_unique<ProfileTrack>());
+			track->Name = "Thread " + std::to_string(tracks.size());
+			threadTrack = track.get();
+		}
+
+		return *threadTrack;
+	}
+
+	void writeString(std::ostream& out, const std::string& text) {
+		out << '"';
+		for (auto c : text) {
+			if (c == '"' || c == '\\') {
+				out << '\\';
+			}
+			out << c;
+		}
+		out << '"';
+	}
+}
+
+int64_t Profiler::Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool Profiler::IsRecording() {
+	return recording.load(std::memory_order_relaxed);
+}
+
+void Profiler::BeginCapture(uint32_t frameCount, const std::filesystem::path& path) {
+	if (IsRecording() || frameCount == 0) {
+		return;
+	}
+
+	captureFramesLeft = frameCount;
+	capturePath = path;
+
+	generation.fetch_add(1, std::memory_order_release);
+	recording.store(true, std::memory_order_release);
+	std::cerr << "profiler: capturing " << frameCount << " frames" << std::endl;
+}
+
+void Profiler::EndFrame() {
+	if (!IsRecording() || --captureFramesLeft > 0) {
+		return;
+	}
+
+	//Zones still open on other threads are dropped, the GPU zones of the last few frames are still in flight
+	recording.store(false, std::memory_order_release);
+	WriteChromeTrace(capturePath);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+	auto& track = currentTrack();
+
+	std::lock_guard lock(tracksMutex);
+	track.Name = name;
+}
+
+ProfileTrack* Profiler::CreateTrack(const std::string& name) {
+	std::lock_guard lock(tracksMutex);
+	auto& track = tracks.emplace_back(std::make_unique<ProfileTrack>());
+	track->Name = name;
+
+	return track.get();
+}
+
+void Profiler::Record(const ProfileEvent& event) {
+	Record(currentTrack(), event);
+}
+
+void Profiler::Record(ProfileTrack& track, const ProfileEvent& event) {
+	if (!IsRecording()) {
+		return;
+	}
+
+	//Only the owner writes, so resetting for a new capture needs no lock
+	auto current = generation.load(std::memory_order_acquire);
+	if (track.Generation.load(std::memory_order_relaxed) != current) {
+		track.Count.store(0, std::memory_order_relaxed);
+		track.Dropped.store(0, std::memory_order_relaxed);
+		track.Generation.store(current, std::memory_order_release);
+	}
+
+	auto count = track.Count.load(std::memory_order_relaxed);
+	if (count >= ProfileTrack::Capacity) {
+		track.Dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	track.Events[count] = event;
+	track.Count.store(count + 1, std::memory_order_release);
+}
+
+bool Profiler::WriteChromeTrace(const std::filesystem::path& path) {
+	std::ofstream out(path);
+	if (!out) {
+		std::cerr << "Profiler: could not open " << path << std::endl;
+		return false;
+	}
+
+	std::lock_guard lock(tracksMutex);
+	auto current = generation.load(std::memory_order_acquire);
+	size_t eventCount = 0;
+	uint32_t dropped = 0;
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	out << std::fixed << std::setprecision(3);
+
+	for (size_t i = 0; i < tracks.size(); i++) {
+		const auto& track = *tracks[i];
+		auto id = i + 1;
+
+		out << (i == 0 ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id << ",\"args\":{\"name\":";
+		writeString(out, track.Name);
+		out << "}},{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id << ",\"args\":{\"sort_index\":" << id << "}}";
+
+		//Acquire pairs with the owner's release, the first count events are complete
+		if (track.Generation.load(std::memory_order_acquire) != current) {
+			continue;
+		}
+
+		auto count = track.Count.load(std::memory_order_acquire);
+		dropped += track.Dropped.load(std::memory_order_relaxed);
+
+		for (uint32_t e = 0; e < count; e++) {
+			const auto& event = track.Events[e];
+			out << ",\n{\"name\":";
+			writeString(out, event.Name);
+			out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << id
+				<< ",\"ts\":" << static_cast<double>(event.Start) / 1000.0
+				<< ",\"dur\":" << static_cast<double>(event.Duration) / 1000.0
+				<< ",\"args\":{\"depth\":" << event.Depth << "}}";
+		}
+		eventCount += count;
+	}
+
+	out << "\n]}\n";
+
+	std::cerr << "profiler: wrote " << eventCount << " events to " << path;
+	if (dropped > 0) {
+		std::cerr << ", " << dropped << " dropped (track full)";
+	}
+	std::cerr << std::endl;
+
+	return static_cast<bool>(out);
+}
+
+ProfileScope::ProfileScope(const char* name)
+	: _name{ name } {
+	if (Profiler::IsRecording()) {
+		_start = Profiler::Now();
+		threadDepth++;
+	}
+}
+
+ProfileScope::~ProfileScope() {
+	if (_start < 0) {
+		return;
+	}
+
+	threadDepth--;
+	Profiler::Record({ .Name = _name, .Start = _start, .Duration = Profiler::Now() - _start, .Depth = threadDepth });
+}
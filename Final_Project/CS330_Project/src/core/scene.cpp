@@ -0,0 +1,669 @@
+#include <core/scene.h>
+#include <core/job_system.h>
+#include <core/profiler.h>
+#include <rendering/occlusion_culler.h>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+	//Box of an affine transformed box, from its center and half extents
+	BoundingBox transformBounds(const BoundingBox& box, const glm::mat4& transform) {
+		auto center = (box.Min + box.Max) * 0.5f;
+		auto extent = (box.Max - box.Min) * 0.5f;
+
+		auto worldCenter = glm::vec3(transform * glm::vec4(center, 1.f));
+		glm::vec3 worldExtent{
+			std::abs(transform[0][0]) * extent.x + std::abs(transform[1][0]) * extent.y + std::abs(transform[2][0]) * extent.z,
+			std::abs(transform[0][1]) * extent.x + std::abs(transform[1][1]) * extent.y + std::abs(transform[2][1]) * extent.z,
+			std::abs(transform[0][2]) * extent.x + std::abs(transform[1][2]) * extent.y + std::abs(transform[2][2]) * extent.z
+		};
+
+		return { worldCenter - worldExtent, worldCenter + worldExtent };
+	}
+
+	//How much of a light reaches the closest point of a box, used to rank lights per renderable
+	float lightInfluence(const PointLightStruct& light, const BoundingBox& bounds) {
+		auto closest = glm::clamp(light.Position, bounds.Min, bounds.Max);
+		auto distance = glm::length(light.Position - closest);
+		auto attenuation = 1.f / (light.Constant + light.Linear * distance + light.Quadratic * distance * distance);
+
+		auto color = glm::max(light.DiffuseColor, light.AmbientColor);
+		return attenuation * std::max({ color.r, color.g, color.b });
+	}
+}
+
+// SPARSE SET
+
+bool SparseSet::Contains(Entity entity) const {
+	auto index = EntityIndex(entity);
+	return index < _sparse.size() && _sparse[index] != EmptyRow && _dense[_sparse[index]] == entity;
+}
+
+uint32_t SparseSet::insertRow(Entity entity) {
+	auto index = EntityIndex(entity);
+	if (index >= _sparse.size()) {
+		_sparse.resize(index + 1, EmptyRow);
+	}
+
+	auto row = static_cast<uint32_t>(_dense.size());
+	_sparse[index] = row;
+	_dense.push_back(entity);
+
+	return row;
+}
+
+uint32_t SparseSet::removeRow(Entity entity) {
+	auto row = _sparse[EntityIndex(entity)];
+	auto last = _dense.back();
+
+	_dense[row] = last;
+	_sparse[EntityIndex(last)] = row;
+
+	_dense.pop_back();
+	_sparse[EntityIndex(entity)] = EmptyRow;
+
+	return row;
+}
+
+uint32_t SparseSet::eraseRow(Entity entity) {
+	auto row = _sparse[EntityIndex(entity)];
+
+	_dense.erase(_dense.begin() + row);
+	for (auto i = row; i < _dense.size(); i++) {
+		_sparse[EntityIndex(_dense[i])] = i;
+	}
+	_sparse[EntityIndex(entity)] = EmptyRow;
+
+	return row;
+}
+
+void SparseSet::reorderRows(const std::vector<uint32_t>& order) {
+	permute(order, _dense);
+	for (uint32_t i = 0; i < _dense.size(); i++) {
+		_sparse[EntityIndex(_dense[i])] = i;
+	}
+}
+
+// TRANSFORM HIERARCHY
+
+void TransformPool::Add(Entity entity, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, Entity parent) {
+	//Parents already have a row, so appending keeps the topological order
+	auto parentRow = parent == NullEntity ? NoParent : RowOf(parent);
+
+	auto row = insertRow(entity);
+	Positions.push_back(position);
+	Rotations.push_back(rotation);
+	Scales.push_back(scale);
+	Parents.push_back(parentRow);
+	Dirty.push_back(0);
+	Local.emplace_back(1.f);
+	World.emplace_back(1.f);
+	_changed.push_back(0);
+
+	MarkDirty(row);
+}
+
+void TransformPool::Remove(Entity entity) {
+	auto row = eraseRow(entity);
+	eraseAt(row, Positions, Rotations, Scales, Parents, Dirty, Local, World, _changed);
+
+	for (auto& parent : Parents) {
+		if (parent == row) {
+			parent = NoParent;
+		}
+		else if (parent != NoParent && parent > row) {
+			parent--;
+		}
+	}
+
+	//Rows shifted down, consumers indexing by row need a full refresh
+	for (auto i = row; i < Dirty.size(); i++) {
+		MarkDirty(i);
+	}
+}
+
+void TransformPool::SetParent(Entity entity, Entity parent) {
+	auto row = RowOf(entity);
+	auto parentRow = parent == NullEntity ? NoParent : RowOf(parent);
+
+	if (parentRow != NoParent) {
+		std::vector<Entity> descendants;
+		GetDescendants(entity, descendants);
+
+		if (parent == entity || std::find(descendants.begin(), descendants.end(), parent) != descendants.end()) {
+			std::cerr << "TransformPool::SetParent: parenting would create a cycle" << std::endl;
+			return;
+		}
+	}
+
+	Parents[row] = parentRow;
+	MarkDirty(row);
+
+	if (parentRow == NoParent || parentRow < row) {
+		return;
+	}
+
+	//Parent now sits after its child: rebuild the order depth first from the roots
+	auto count = static_cast<uint32_t>(Size());
+	std::vector<std::vector<uint32_t>> children(count);
+	std::vector<uint32_t> stack;
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (Parents[i] == NoParent) {
+			stack.push_back(i);
+		}
+		else {
+			children[Parents[i]].push_back(i);
+		}
+	}
+	std::reverse(stack.begin(), stack.end());
+
+	std::vector<uint32_t> order;
+	order.reserve(count);
+	while (!stack.empty()) {
+		auto current = stack.back();
+		stack.pop_back();
+		order.push_back(current);
+		stack.insert(stack.end(), children[current].rbegin(), children[current].rend());
+	}
+
+	std::vector<uint32_t> newRows(count);
+	for (uint32_t i = 0; i < count; i++) {
+		newRows[order[i]] = i;
+	}
+
+	reorderRows(order);
+	permute(order, Positions, Rotations, Scales, Parents, Dirty, Local, World, _changed);
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (Parents[i] != NoParent) {
+			Parents[i] = newRows[Parents[i]];
+		}
+		MarkDirty(i);
+	}
+}
+
+void TransformPool::GetDescendants(Entity entity, std::vector<Entity>& descendants) const {
+	auto row = RowOf(entity);
+	const auto& entities = GetEntities();
+
+	//Topological order: every descendant comes after its ancestors
+	std::vector<uint8_t> inSubtree(entities.size() - row, 0);
+	inSubtree[0] = 1;
+
+	for (auto i = row + 1; i < entities.size(); i++) {
+		auto parent = Parents[i];
+		if (parent != NoParent && parent >= row && inSubtree[parent - row]) {
+			inSubtree[i - row] = 1;
+			descendants.push_back(entities[i]);
+		}
+	}
+}
+
+void TransformPool::SetPosition(Entity entity, const glm::vec3& position) {
+	auto row = RowOf(entity);
+	Positions[row] = position;
+	MarkDirty(row);
+}
+
+void TransformPool::SetRotation(Entity entity, const glm::quat& rotation) {
+	auto row = RowOf(entity);
+	Rotations[row] = rotation;
+	MarkDirty(row);
+}
+
+void TransformPool::SetScale(Entity entity, const glm::vec3& scale) {
+	auto row = RowOf(entity);
+	Scales[row] = scale;
+	MarkDirty(row);
+}
+
+void TransformPool::UpdateWorldMatrices(JobSystem& jobs) {
+	_changedRanges.clear();
+
+	//Static scenes stop here
+	if (!_anyDirty) {
+		return;
+	}
+
+	auto count = static_cast<uint32_t>(Size());
+
+	//Local matrices only depend on their own row
+	jobs.ParallelFor(0, count, 1024, [this](uint32_t first, uint32_t last) {
+		for (auto i = first; i < last; i++) {
+			if (!Dirty[i]) {
+				continue;
+			}
+
+			auto rotation = glm::mat3_cast(Rotations[i]);
+			const auto& scale = Scales[i];
+
+			Local[i] = {
+				glm::vec4(rotation[0] * scale.x, 0.f),
+				glm::vec4(rotation[1] * scale.y, 0.f),
+				glm::vec4(rotation[2] * scale.z, 0.f),
+				glm::vec4(Positions[i], 1.f)
+			};
+		}
+	});
+
+	//Parents come first, so one ordered pass propagates changes down the hierarchy
+	for (uint32_t i = 0; i < count; i++) {
+		auto parent = Parents[i];
+		auto changed = Dirty[i] || (parent != NoParent && _changed[parent]);
+
+		_changed[i] = changed;
+		if (!changed) {
+			continue;
+		}
+		Dirty[i] = 0;
+
+		World[i] = parent == NoParent ? Local[i] : World[parent] * Local[i];
+
+		if (!_changedRanges.empty() && _changedRanges.back().First + _changedRanges.back().Count == i) {
+			_changedRanges.back().Count++;
+		}
+		else {
+			_changedRanges.push_back({ i, 1 });
+		}
+	}
+
+	_anyDirty = false;
+}
+
+// POOLS
+
+void RenderablePool::Add(Entity entity, Mesh* mesh, MaterialId material) {
+	insertRow(entity);
+	Meshes.push_back(mesh);
+	Materials.push_back(material);
+	WorldBounds.emplace_back();
+	LightSets.emplace_back().fill(DrawPacket::NoLight);
+	PendingBounds.push_back(entity);
+	LayoutVersion++;
+}
+
+void RenderablePool::Remove(Entity entity) {
+	swapPop(removeRow(entity), Meshes, Materials, WorldBounds, LightSets);
+	LayoutVersion++;
+}
+
+void ProceduralPool::Add(Entity entity, ProceduralShape shape, uint32_t sectors, const glm::vec2& size, MaterialId material) {
+	insertRow(entity);
+	Shapes.push_back(shape);
+	Sectors.push_back(sectors);
+	Sizes.push_back(size);
+	Materials.push_back(material);
+	Version++;
+}
+
+void ProceduralPool::Remove(Entity entity) {
+	swapPop(removeRow(entity), Shapes, Sectors, Sizes, Materials);
+	Version++;
+}
+
+void PointLightPool::Add(Entity entity, const PointLightStruct& light) {
+	insertRow(entity);
+	AmbientColors.push_back(light.AmbientColor);
+	DiffuseColors.push_back(light.DiffuseColor);
+	SpecularColors.push_back(light.SpecularColor);
+	Constants.push_back(light.Constant);
+	Linears.push_back(light.Linear);
+	Quadratics.push_back(light.Quadratic);
+}
+
+void PointLightPool::Remove(Entity entity) {
+	swapPop(removeRow(entity), AmbientColors, DiffuseColors, SpecularColors, Constants, Linears, Quadratics);
+}
+
+void BehaviourPool::Add(Entity entity, BehaviourKind kind, const glm::vec3& axisOrOrigin, float speed, float radius) {
+	insertRow(entity);
+	Kinds.push_back(kind);
+	Axes.push_back(kind == BehaviourKind::Spin ? glm::normalize(axisOrOrigin) : glm::vec3{ 0.f, 1.f, 0.f });
+	Origins.push_back(kind == BehaviourKind::Orbit ? axisOrOrigin : glm::vec3{});
+	Speeds.push_back(speed);
+	Radii.push_back(radius);
+	Elapsed.push_back(0.f);
+	PreviousPositions.emplace_back();
+	CurrentPositions.emplace_back();
+	PreviousRotations.emplace_back(1.f, 0.f, 0.f, 0.f);
+	CurrentRotations.emplace_back(1.f, 0.f, 0.f, 0.f);
+	Started.push_back(0);
+}
+
+void BehaviourPool::Remove(Entity entity) {
+	swapPop(removeRow(entity), Kinds, Axes, Origins, Speeds, Radii, Elapsed, PreviousPositions, CurrentPositions, PreviousRotations, CurrentRotations, Started);
+}
+
+// SCENE
+
+Entity Scene::CreateEntity() {
+	uint32_t index;
+	if (!_freeSlots.empty()) {
+		index = _freeSlots.back();
+		_freeSlots.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(_generations.size());
+		_generations.push_back(0);
+	}
+
+	_entityCount++;
+	return (static_cast<uint32_t>(_generations[index]) << EntityIndexBits) | index;
+}
+
+void Scene::DestroyEntity(Entity entity) {
+	if (!IsAlive(entity)) {
+		return;
+	}
+
+	//Children first, deepest rows first, so no transform is left with a missing parent
+	if (Transforms.Contains(entity)) {
+		std::vector<Entity> descendants;
+		Transforms.GetDescendants(entity, descendants);
+
+		for (auto it = descendants.rbegin(); it != descendants.rend(); it++) {
+			destroySingle(*it);
+		}
+	}
+
+	destroySingle(entity);
+}
+
+void Scene::destroySingle(Entity entity) {
+	if (Transforms.Contains(entity)) Transforms.Remove(entity);
+	if (Renderables.Contains(entity)) Renderables.Remove(entity);
+	if (Procedurals.Contains(entity)) Procedurals.Remove(entity);
+	if (PointLights.Contains(entity)) PointLights.Remove(entity);
+	if (Behaviours.Contains(entity)) Behaviours.Remove(entity);
+
+	auto index = EntityIndex(entity);
+	_generations[index]++;
+	_freeSlots.push_back(index);
+	_entityCount--;
+}
+
+bool Scene::IsAlive(Entity entity) const {
+	auto index = EntityIndex(entity);
+	return entity != NullEntity && index < _generations.size() && _generations[index] == (entity >> EntityIndexBits);
+}
+
+void Scene::Step(float deltaTime, JobSystem& jobs) {
+	PROFILE_SCOPE("Behaviours");
+	stepBehaviours(deltaTime, jobs);
+}
+
+bool Scene::Update(float interpolation, JobSystem& jobs) {
+	PROFILE_SCOPE("Scene update");
+
+	{
+		PROFILE_SCOPE("Interpolate");
+		interpolateBehaviours(interpolation, jobs);
+	}
+
+	{
+		PROFILE_SCOPE("World matrices");
+		Transforms.UpdateWorldMatrices(jobs);
+	}
+
+	{
+		PROFILE_SCOPE("Renderable bounds");
+		updateRenderableBounds(jobs);
+		updateProceduralVersion();
+	}
+
+	return !Transforms.GetChangedRanges().empty() || !_changedRenderables.empty();
+}
+
+void Scene::stepBehaviours(float deltaTime, JobSystem& jobs) {
+	const auto& entities = Behaviours.GetEntities();
+
+	//Every behaviour writes only its own row, the transforms are posed from it in Update
+	jobs.ParallelFor(0, static_cast<uint32_t>(entities.size()), 256, [&](uint32_t first, uint32_t last) {
+		for (auto i = first; i < last; i++) {
+			if (!Transforms.Contains(entities[i])) {
+				continue;
+			}
+
+			if (!Behaviours.Started[i]) {
+				auto row = Transforms.RowOf(entities[i]);
+				Behaviours.CurrentPositions[i] = Transforms.Positions[row];
+				Behaviours.CurrentRotations[i] = Transforms.Rotations[row];
+				Behaviours.Started[i] = 1;
+			}
+
+			Behaviours.PreviousPositions[i] = Behaviours.CurrentPositions[i];
+			Behaviours.PreviousRotations[i] = Behaviours.CurrentRotations[i];
+			auto elapsed = Behaviours.Elapsed[i] += deltaTime;
+
+			switch (Behaviours.Kinds[i]) {
+				case BehaviourKind::Spin: {
+					auto spin = glm::angleAxis(Behaviours.Speeds[i] * deltaTime, Behaviours.Axes[i]);
+					Behaviours.CurrentRotations[i] = glm::normalize(spin * Behaviours.CurrentRotations[i]);
+					break;
+				}
+				case BehaviourKind::Orbit: {
+					auto angle = Behaviours.Speeds[i] * elapsed;
+					auto radius = Behaviours.Radii[i];
+					Behaviours.CurrentPositions[i] = Behaviours.Origins[i] + glm::vec3{ std::cos(angle) * radius, 0.f, std::sin(angle) * radius };
+					break;
+				}
+			}
+		}
+	});
+}
+
+void Scene::interpolateBehaviours(float interpolation, JobSystem& jobs) {
+	const auto& entities = Behaviours.GetEntities();
+
+	jobs.ParallelFor(0, static_cast<uint32_t>(entities.size()), 256, [&](uint32_t first, uint32_t last) {
+		for (auto i = first; i < last; i++) {
+			if (!Behaviours.Started[i] || !Transforms.Contains(entities[i])) {
+				continue;
+			}
+
+			auto row = Transforms.RowOf(entities[i]);
+			switch (Behaviours.Kinds[i]) {
+				case BehaviourKind::Spin: {
+					Transforms.Rotations[row] = glm::slerp(Behaviours.PreviousRotations[i], Behaviours.CurrentRotations[i], interpolation);
+					break;
+				}
+				case BehaviourKind::Orbit: {
+					Transforms.Positions[row] = glm::mix(Behaviours.PreviousPositions[i], Behaviours.CurrentPositions[i], interpolation);
+					break;
+				}
+			}
+			Transforms.MarkDirty(row);
+		}
+	});
+}
+
+void Scene::updateRenderableBounds(JobSystem& jobs) {
+	const auto& entities = Transforms.GetEntities();
+	_changedRenderables.clear();
+
+	//New renderables on transforms that may not move again
+	for (auto entity : Renderables.PendingBounds) {
+		if (Renderables.Contains(entity) && Transforms.Contains(entity)) {
+			auto renderableRow = Renderables.RowOf(entity);
+			Renderables.WorldBounds[renderableRow] = transformBounds(Renderables.Meshes[renderableRow]->GetBounds(), Transforms.World[Transforms.RowOf(entity)]);
+			_changedRenderables.push_back(renderableRow);
+		}
+	}
+	Renderables.PendingBounds.clear();
+
+	//Only transforms that moved this frame, every row maps to a distinct renderable
+	for (const auto& range : Transforms.GetChangedRanges()) {
+		jobs.ParallelFor(range.First, range.First + range.Count, 512, [&](uint32_t first, uint32_t last) {
+			for (auto row = first; row < last; row++) {
+				if (!Renderables.Contains(entities[row])) {
+					continue;
+				}
+
+				auto renderableRow = Renderables.RowOf(entities[row]);
+				Renderables.WorldBounds[renderableRow] = transformBounds(Renderables.Meshes[renderableRow]->GetBounds(), Transforms.World[row]);
+			}
+		});
+
+		//Serial pass, the changed set is small next to the bounds work
+		for (auto row = range.First; row < range.First + range.Count; row++) {
+			if (Renderables.Contains(entities[row])) {
+				_changedRenderables.push_back(Renderables.RowOf(entities[row]));
+			}
+		}
+	}
+
+	std::sort(_changedRenderables.begin(), _changedRenderables.end());
+	_changedRenderables.erase(std::unique(_changedRenderables.begin(), _changedRenderables.end()), _changedRenderables.end());
+}
+
+void Scene::updateProceduralVersion() {
+	if (Procedurals.Size() == 0) {
+		return;
+	}
+
+	const auto& entities = Transforms.GetEntities();
+	for (const auto& range : Transforms.GetChangedRanges()) {
+		for (auto row = range.First; row < range.First + range.Count; row++) {
+			if (Procedurals.Contains(entities[row])) {
+				Procedurals.Version++;
+				return;
+			}
+		}
+	}
+}
+
+void Scene::GatherLights(FrameSnapshot& frame) {
+	const auto& entities = PointLights.GetEntities();
+	_lights.clear();
+
+	for (size_t i = 0; i < entities.size(); i++) {
+		const auto& world = Transforms.World[Transforms.RowOf(entities[i])];
+
+		_lights.push_back({
+			.Position = glm::vec3(world[3]),
+			.AmbientColor = PointLights.AmbientColors[i],
+			.DiffuseColor = PointLights.DiffuseColors[i],
+			.SpecularColor = PointLights.SpecularColors[i],
+			.Constant = PointLights.Constants[i],
+			.Linear = PointLights.Linears[i],
+			.Quadratic = PointLights.Quadratics[i]
+		});
+
+		if (frame.SceneParams.Lights.size() < MAX_POINT_LIGHTS) {
+			frame.SceneParams.Lights.push_back(_lights.back());
+		}
+	}
+
+	_perRenderableLights = _lights.size() > MAX_POINT_LIGHTS;
+
+	frame.Lights = _lights;
+	frame.PerPacketLights = _perRenderableLights;
+}
+
+void Scene::AssignLights(const std::vector<uint32_t>& rows, JobSystem& jobs) {
+	//Everything fits in the shared uniforms, Draw skips the per renderable sets
+	if (!_perRenderableLights) {
+		return;
+	}
+
+	jobs.ParallelFor(0, static_cast<uint32_t>(rows.size()), 128, [this, &rows](uint32_t first, uint32_t last) {
+		for (auto i = first; i < last; i++) {
+			SelectLights(Renderables.WorldBounds[rows[i]], Renderables.LightSets[rows[i]]);
+		}
+	});
+}
+
+void Scene::SelectLights(const BoundingBox& bounds, LightSet& lightSet) const {
+	std::array<float, MAX_POINT_LIGHTS> scores;
+	lightSet.fill(DrawPacket::NoLight);
+	scores.fill(0.f);
+
+	//Insertion into a sorted top MAX_POINT_LIGHTS list
+	for (uint16_t light = 0; light < _lights.size(); light++) {
+		auto score = lightInfluence(_lights[light], bounds);
+		if (score <= scores[MAX_POINT_LIGHTS - 1]) {
+			continue;
+		}
+
+		auto slot = MAX_POINT_LIGHTS - 1;
+		while (slot > 0 && scores[slot - 1] < score) {
+			scores[slot] = scores[slot - 1];
+			lightSet[slot] = lightSet[slot - 1];
+			slot--;
+		}
+		scores[slot] = score;
+		lightSet[slot] = light;
+	}
+}
+
+void Scene::GatherVisible(OcclusionCuller* culler, std::vector<uint32_t>& visibleRows, JobSystem& jobs) const {
+	visibleRows.clear();
+
+	auto count = static_cast<uint32_t>(Renderables.Size());
+	if (!culler) {
+		visibleRows.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			visibleRows[i] = i;
+		}
+		return;
+	}
+
+	//Fixed chunks with their own output, joined in row order so draws stay sorted
+	constexpr uint32_t chunkSize = 256;
+	std::vector<std::vector<uint32_t>> chunkRows((count + chunkSize - 1) / chunkSize);
+
+	jobs.ParallelFor(0, static_cast<uint32_t>(chunkRows.size()), 1, [&](uint32_t firstChunk, uint32_t lastChunk) {
+		for (auto chunk = firstChunk; chunk < lastChunk; chunk++) {
+			auto last = std::min(count, (chunk + 1) * chunkSize);
+			for (auto i = chunk * chunkSize; i < last; i++) {
+				if (culler->IsVisible(Renderables.WorldBounds[i])) {
+					chunkRows[chunk].push_back(i);
+				}
+			}
+		}
+	});
+
+	visibleRows.reserve(count);
+	for (const auto& rows : chunkRows) {
+		visibleRows.insert(visibleRows.end(), rows.begin(), rows.end());
+	}
+}
+
+void Scene::GatherDrawPackets(const std::vector<uint32_t>& visibleRows, uint32_t first, uint32_t last, std::vector<DrawPacket>& packets) const {
+	const auto& entities = Renderables.GetEntities();
+
+	for (auto i = first; i < last; i++) {
+		auto row = visibleRows[i];
+		packets.push_back({
+			.Geometry = Renderables.Meshes[row],
+			.Material = Renderables.Materials[row],
+			.Model = Transforms.World[Transforms.RowOf(entities[row])],
+			.Lights = Renderables.LightSets[row]
+		});
+	}
+}
+
+GpuObjectRecord Scene::GetGpuObject(uint32_t row) const {
+	return {
+		.Geometry = Renderables.Meshes[row],
+		.Material = Renderables.Materials[row],
+		.Model = Transforms.World[Transforms.RowOf(Renderables.GetEntities()[row])],
+		.Bounds = Renderables.WorldBounds[row]
+	};
+}
+void Scene::GatherProceduralInstances(std::vector<ProceduralInstance>& instances) const {
+	const auto& entities = Procedurals.GetEntities();
+	instances.clear();
+	instances.reserve(entities.size());
+
+	for (size_t i = 0; i < entities.size(); i++) {
+		instances.push_back({
+			.Shape = Procedurals.Shapes[i],
+			.Sectors = Procedurals.Sectors[i],
+			.Size = Procedurals.Sizes[i],
+			.Material = Procedurals.Materials[i],
+			.Model = Transforms.World[Transforms.RowOf(entities[i])]
+		});
+	}
+}
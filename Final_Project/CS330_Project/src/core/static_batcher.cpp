@@ -0,0 +1,158 @@
+#include <core/static_batcher.h>
+#include <core/scene.h>
+#include <rendering/shader.h>
+#include <rendering/texture.h>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+	//Same files means same material, even when every object loaded its own copy
+	bool sameShader(const Shader* a, const Shader* b) {
+		if (a == b) {
+			return true;
+		}
+		return !a->GetVertexPath().empty() && a->GetVertexPath() == b->GetVertexPath() && a->GetFragmentPath() == b->GetFragmentPath();
+	}
+
+	bool sameTexture(const Texture* a, const Texture* b) {
+		return a == b || (a && b && a->GetPath() == b->GetPath());
+	}
+
+	//Everything but the color, that one is baked into the vertices
+	bool canMerge(const Material& a, const Material& b) {
+		return sameShader(a.Program, b.Program) &&
+			sameTexture(a.Textures[0], b.Textures[0]) &&
+			sameTexture(a.Textures[1], b.Textures[1]) &&
+			a.SpecularStrength == b.SpecularStrength &&
+			a.Shininess == b.Shininess &&
+			a.TextureMix == b.TextureMix;
+	}
+
+	struct BatchInput {
+		Material BatchMaterial{};
+		std::vector<Vertex> Vertices{};
+		std::vector<uint32_t> Elements{};
+		std::vector<StaticBatchSource> Sources{};
+	};
+}
+
+void StaticBatcher::Build(const std::vector<std::unique_ptr<GameObject>>& objects, MaterialLibrary& materials) {
+	_batches.clear();
+
+	std::vector<BatchInput> inputs;
+	uint32_t modelCount = 0;
+
+	for (const auto& object : objects) {
+		if (!object->IsStatic) {
+			continue;
+		}
+
+		//Same packets the object would emit, so materials match its unbatched draws
+		std::vector<DrawPacket> packets;
+		object->GatherDrawPackets(packets);
+
+		for (uint32_t modelIndex = 0; modelIndex < packets.size(); modelIndex++) {
+			const auto& packet = packets[modelIndex];
+			const auto& material = materials.Get(packet.Material);
+
+			auto input = std::find_if(inputs.begin(), inputs.end(), [&material](const BatchInput& candidate) {
+				return canMerge(candidate.BatchMaterial, material);
+			});
+
+			if (input == inputs.end()) {
+				auto batchMaterial = material;
+				batchMaterial.Color = glm::vec3(1.f);
+				input = inputs.insert(inputs.end(), BatchInput{ .BatchMaterial = batchMaterial });
+			}
+
+			const auto& vertices = packet.Geometry->GetVertices();
+			const auto& elements = packet.Geometry->GetElements();
+
+			auto normalMatrix = glm::transpose(glm::inverse(glm::mat3(packet.Model)));
+			auto baseVertex = static_cast<uint32_t>(input->Vertices.size());
+
+			StaticBatchSource source{
+				.Object = object.get(),
+				.ModelIndex = modelIndex,
+				.FirstElement = static_cast<uint32_t>(input->Elements.size()),
+				.ElementCount = static_cast<uint32_t>(elements.size())
+			};
+
+			for (auto vertex : vertices) {
+				vertex.Position = glm::vec3(packet.Model * glm::vec4(vertex.Position, 1.f));
+				vertex.Normal = normalMatrix * vertex.Normal;
+				vertex.Color *= material.Color;
+				source.Bounds.Expand(vertex.Position);
+				input->Vertices.push_back(vertex);
+			}
+
+			for (auto element : elements) {
+				input->Elements.push_back(baseVertex + element);
+			}
+
+			input->Sources.push_back(source);
+			modelCount++;
+		}
+	}
+
+	size_t gpuBytes = 0;
+
+	for (auto& input : inputs) {
+		//Batches are the largest meshes, 16 bit positions over their world bounds are still well below a millimetre
+		auto& batch = _batches.emplace_back();
+		//Triangles keep their order so Sources stay valid, each source was cache optimized as its own mesh
+		batch.Geometry = std::make_unique<Mesh>(input.Vertices, input.Elements, VertexFormat::Quantized,
+			MeshProcessingOptions{ .OptimizeVertexCache = false, .OptimizeOverdraw = false });
+		batch.Material = materials.Add(input.BatchMaterial);
+		batch.Bounds = batch.Geometry->GetBounds();
+		batch.Lights.fill(DrawPacket::NoLight);
+		batch.Sources = std::move(input.Sources);
+		gpuBytes += batch.Geometry->GetGpuBytes();
+	}
+
+	std::cerr << "static batching: " << modelCount << " models merged into " << _batches.size() << " batches, " << gpuBytes << " bytes" << std::endl;
+}
+
+const StaticBatchSource* StaticBatcher::FindSource(uint32_t batchIndex, uint32_t firstElement) const {
+	if (batchIndex >= _batches.size()) {
+		return nullptr;
+	}
+
+	const auto& sources = _batches[batchIndex].Sources;
+	auto it = std::upper_bound(sources.begin(), sources.end(), firstElement, [](uint32_t element, const StaticBatchSource& source) {
+		return element < source.FirstElement;
+	});
+
+	if (it == sources.begin()) {
+		return nullptr;
+	}
+
+	--it;
+	return firstElement < it->FirstElement + it->ElementCount ? &*it : nullptr;
+}
+
+void StaticBatcher::AssignLights(const Scene& scene, const std::vector<uint8_t>& batchVisible) {
+	if (!scene.HasPerPacketLights()) {
+		return;
+	}
+
+	for (size_t i = 0; i < _batches.size(); i++) {
+		if (i >= batchVisible.size() || batchVisible[i]) {
+			scene.SelectLights(_batches[i].Bounds, _batches[i].Lights);
+		}
+	}
+}
+
+void StaticBatcher::GatherDrawPackets(const std::vector<uint8_t>& batchVisible, std::vector<DrawPacket>& packets) const {
+	for (size_t i = 0; i < _batches.size(); i++) {
+		if (i < batchVisible.size() && !batchVisible[i]) {
+			continue;
+		}
+
+		const auto& batch = _batches[i];
+		auto& packet = packets.emplace_back();
+		packet.Geometry = batch.Geometry.get();
+		packet.Material = batch.Material;
+		packet.Lights = batch.Lights;
+	}
+}
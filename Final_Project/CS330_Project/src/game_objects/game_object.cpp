@@ -0,0 +1,22 @@
+#include <game_objects/game_object.h>
+
+BoundingBox GameObject::GetWorldBounds() const {
+	BoundingBox bounds{};
+
+	for (const auto& model : _models) {
+		const auto* mesh = model.GetMesh();
+		bounds.Expand(mesh->GetBounds().Transformed(Transform * mesh->Transform));
+	}
+
+	return bounds;
+}
+
+void GameObject::GatherDrawPackets(std::vector<DrawPacket>& packets) {
+	for (auto& model : _models) {
+		auto& packet = packets.emplace_back();
+		packet.Geometry = model.GetMesh();
+		packet.Material = model.GetMaterial();
+		packet.Model = Transform * model.GetMesh()->Transform;
+		packet.Lights.fill(DrawPacket::NoLight);
+	}
+}
\ No newline at end of file
@@ -1,9 +1,14 @@
-#include <iostream>         // cout, cerr
-#include <application.h>
-
-int main(int argc, char* argv[]) {
-    Application app{ "CS330_OpenGL_Project", 800, 600 };
-
-    app.Run();
-    return 0;
+#include <iostream>         // cout, cerr
+#include <application.h>
+
+int main(int argc, char* argv[]) {
+    LaunchOptions options{};
+    if (!ParseLaunchOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    Application app{ "CS330_OpenGL_Project", 800, 600, options };
+
+    app.Run();
+    return 0;
 }
\ No newline at end of file
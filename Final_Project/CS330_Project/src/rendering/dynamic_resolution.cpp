@@ -0,0 +1,179 @@
+#include <rendering/dynamic_resolution.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+	//Scale changes in at least this step, smaller ones aren't worth the blur of resampling
+	constexpr float ScaleStep = 0.05f;
+	//Recent frames over the budget before scaling down, one slow frame is not a trend
+	constexpr uint32_t DownFrames = 3;
+	//Recent frames under UpHeadroom of the budget before scaling up, about half a second
+	constexpr uint32_t UpFrames = 30;
+	constexpr double UpHeadroom = 0.8;
+	//Scaling down aims this far under the budget, for some headroom against the next spike
+	constexpr double DownTarget = 0.9;
+}
+
+DynamicResolution::~DynamicResolution() {
+	Release();
+}
+
+bool DynamicResolution::Init() {
+	_shader = std::make_unique<Shader>(Shader::ShaderPath / "upscale.vert", Shader::ShaderPath / "upscale.frag");
+
+	//The triangle comes from gl_VertexID, the core profile still wants a vertex array bound
+	glGenVertexArrays(1, &_vertexArray);
+	glGenQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+
+	return _shader->GetHandle() != 0;
+}
+
+void DynamicResolution::Release() {
+	if (!_vertexArray) {
+		return;
+	}
+
+	glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+	glDeleteVertexArrays(1, &_vertexArray);
+	_vertexArray = 0;
+	_pending = {};
+	_shader.reset();
+}
+
+void DynamicResolution::BeginFrame(float budgetMilliseconds) {
+	if (!_vertexArray) {
+		return;
+	}
+
+	//Without a budget the scene goes straight to the output again
+	if (budgetMilliseconds != _budgetMilliseconds) {
+		_budgetMilliseconds = budgetMilliseconds;
+		_scale = MaxScale;
+		_historyCount = 0;
+		_framesOverBudget = 0;
+		_framesUnderBudget = 0;
+		_settleFrames = QueryLatency;
+	}
+
+	collect();
+	glQueryCounter(_queries[_frameIndex % QueryLatency * 2], GL_TIMESTAMP);
+	_timing = true;
+
+	_scaled = _budgetMilliseconds > 0.f && _scale < MaxScale;
+}
+
+glm::ivec2 DynamicResolution::GetSceneSize(int width, int height) const {
+	if (!_scaled) {
+		return { width, height };
+	}
+
+	return {
+		std::max(1, static_cast<int>(std::lround(width * _scale))),
+		std::max(1, static_cast<int>(std::lround(height * _scale)))
+	};
+}
+
+void DynamicResolution::Upscale(GLuint source, glm::ivec2 sceneSize, float sharpness) {
+	auto depthTest = glIsEnabled(GL_DEPTH_TEST);
+	glDisable(GL_DEPTH_TEST);
+
+	//Sharpening restores some of the detail lost to the lower resolution, nothing to restore at full scale
+	_shader->Bind();
+	_shader->SetVec2("sourceSize", glm::vec2(sceneSize));
+	_shader->SetFloat("sharpness", std::clamp(sharpness, 0.f, 1.f));
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, source);
+	glBindVertexArray(_vertexArray);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	//Not left bound while the next frame renders into it
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (depthTest) {
+		glEnable(GL_DEPTH_TEST);
+	}
+}
+
+void DynamicResolution::EndFrame() {
+	if (!_timing) {
+		return;
+	}
+
+	glQueryCounter(_queries[_frameIndex % QueryLatency * 2 + 1], GL_TIMESTAMP);
+	_pending[_frameIndex % QueryLatency] = true;
+	_frameIndex++;
+	_timing = false;
+}
+
+void DynamicResolution::collect() {
+	auto slot = _frameIndex % QueryLatency;
+	if (!_pending[slot]) {
+		return;
+	}
+	_pending[slot] = false;
+
+	//QueryLatency frames old, still not done means the GPU is far behind. Dropped rather than waited for
+	GLint available = 0;
+	glGetQueryObjectiv(_queries[slot * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) {
+		return;
+	}
+
+	GLuint64 begin = 0;
+	GLuint64 end = 0;
+	glGetQueryObjectui64v(_queries[slot * 2], GL_QUERY_RESULT, &begin);
+	glGetQueryObjectui64v(_queries[slot * 2 + 1], GL_QUERY_RESULT, &end);
+	_gpuMilliseconds = static_cast<double>(end - begin) / 1e6;
+
+	updateScale(_gpuMilliseconds, _budgetMilliseconds);
+}
+
+void DynamicResolution::updateScale(double milliseconds, float budgetMilliseconds) {
+	if (budgetMilliseconds <= 0.f) {
+		return;
+	}
+
+	//Frames queued before the last change were rendered at the old scale
+	if (_settleFrames > 0) {
+		_settleFrames--;
+		return;
+	}
+
+	_history[_historyCount % HistorySize] = milliseconds;
+	_historyCount++;
+
+	auto samples = std::min(_historyCount, HistorySize);
+	auto average = std::accumulate(_history.begin(), _history.begin() + samples, 0.0) / samples;
+
+	auto scale = _scale;
+	if (average > budgetMilliseconds) {
+		_framesUnderBudget = 0;
+		if (++_framesOverBudget >= DownFrames) {
+			//The cost is mostly per pixel, so it goes with the square of the scale. Straight to the
+			//estimate, a collapsing frame rate shouldn't take several steps to recover
+			auto estimate = _scale * static_cast<float>(std::sqrt(budgetMilliseconds * DownTarget / average));
+			scale = std::max(MinScale, std::min(estimate, _scale - ScaleStep));
+		}
+	}
+	else if (average < budgetMilliseconds * UpHeadroom) {
+		_framesOverBudget = 0;
+		if (++_framesUnderBudget >= UpFrames) {
+			scale = std::min(MaxScale, _scale + ScaleStep);
+		}
+	}
+	else {
+		_framesOverBudget = 0;
+		_framesUnderBudget = 0;
+	}
+
+	if (scale != _scale) {
+		_scale = scale;
+		_historyCount = 0;
+		_framesOverBudget = 0;
+		_framesUnderBudget = 0;
+		_settleFrames = QueryLatency;
+	}
+}
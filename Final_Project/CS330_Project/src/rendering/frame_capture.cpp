@@ -0,0 +1,274 @@
+#include <rendering/frame_capture.h>
+#include <rendering/gpu_memory.h>
+#include <rendering/gl_trace.h>
+#include <core/profiler.h>
+#include <stb_image_write.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+	void writeToStream(void* context, void* data, int size) {
+		static_cast<std::ofstream*>(context)->write(static_cast<const char*>(data), size);
+	}
+}
+
+FrameCapture::~FrameCapture() {
+	Release();
+}
+
+void FrameCapture::Init() {
+	_stopping = false;
+	_next = 0;
+
+	//Low compression, sequences are written at frame rate and compressing harder barely pays off on renders
+	stbi_write_png_compression_level = 2;
+	stbi_write_tga_with_rle = 1;
+
+	for (uint32_t i = 0; i < EncoderThreads; i++) {
+		_encoders.emplace_back(&FrameCapture::encoderLoop, this);
+	}
+
+	_initialized = true;
+}
+
+void FrameCapture::Release() {
+	if (!_initialized) {
+		return;
+	}
+
+	//Oldest first, so sequences reach the encoders in order
+	for (uint32_t i = 0; i < RingSize; i++) {
+		auto& readback = _ring[(_next + i) % RingSize];
+		collect(readback, true);
+		resize(readback, 0, 0);
+	}
+
+	{
+		std::lock_guard lock(_mutex);
+		_stopping = true;
+	}
+	_queued.notify_all();
+
+	//Encoders drain the queue before they stop
+	for (auto& encoder : _encoders) {
+		encoder.join();
+	}
+	_encoders.clear();
+
+	auto stats = GetStats();
+	if (stats.Captured > 0) {
+		std::cerr << "capture: " << stats.Written << " of " << stats.Captured << " frames written, " << stats.ReadbackWaits << " readback waits, "
+			<< stats.EncoderWaits << " encoder waits" << std::endl;
+	}
+
+	_initialized = false;
+}
+
+void FrameCapture::EndFrame(const std::filesystem::path& path, int width, int height) {
+	if (!_initialized) {
+		return;
+	}
+
+	PROFILE_SCOPE("Frame capture");
+	GL_TRACE_SCOPE("Frame capture");
+
+	//Everything the GPU finished so far, in capture order. Stops at the first one still busy so
+	//the images of a sequence are queued in order
+	for (uint32_t i = 0; i < RingSize; i++) {
+		if (!collect(_ring[(_next + i) % RingSize], false)) {
+			break;
+		}
+	}
+
+	if (path.empty() || width <= 0 || height <= 0) {
+		return;
+	}
+
+	//The oldest readback is RingSize - 1 frames old, it is only still busy when the GPU is far behind
+	auto& readback = _ring[_next];
+	_next = (_next + 1) % RingSize;
+
+	if (readback.Fence) {
+		std::lock_guard lock(_mutex);
+		_stats.ReadbackWaits++;
+	}
+	collect(readback, true);
+
+	if (readback.Width != width || readback.Height != height) {
+		resize(readback, width, height);
+	}
+	if (!readback.Mapped) {
+		return;
+	}
+
+	//Reads from whatever is bound for reading, the window's back buffer or the offscreen target. The
+	//copy into the bound pixel buffer happens on the GPU, glReadPixels returns right away
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.Buffer);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	readback.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	readback.Path = path;
+
+	std::lock_guard lock(_mutex);
+	_stats.Captured++;
+}
+
+FrameCaptureStats FrameCapture::GetStats() {
+	std::lock_guard lock(_mutex);
+	return _stats;
+}
+
+void FrameCapture::resize(Readback& readback, int width, int height) {
+	if (readback.Buffer) {
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.Buffer);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		GpuMemory::Forget(GpuMemory::Kind::Buffer, readback.Buffer);
+		glDeleteBuffers(1, &readback.Buffer);
+		readback = {};
+	}
+
+	if (width <= 0 || height <= 0) {
+		return;
+	}
+
+	//Persistent and coherent like the stream buffer, only read by the CPU after the fence signaled
+	constexpr GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	auto size = static_cast<GLsizeiptr>(width) * height * 4;
+
+	glGenBuffers(1, &readback.Buffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.Buffer);
+	glBufferStorage(GL_PIXEL_PACK_BUFFER, size, nullptr, flags | GL_CLIENT_STORAGE_BIT);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, readback.Buffer, size);
+	readback.Mapped = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, flags));
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (!readback.Mapped) {
+		std::cerr << "FrameCapture: failed to map a " << width << "x" << height << " readback buffer" << std::endl;
+		return;
+	}
+
+	readback.Width = width;
+	readback.Height = height;
+}
+
+bool FrameCapture::collect(Readback& readback, bool wait) {
+	if (!readback.Fence) {
+		return true;
+	}
+
+	auto result = glClientWaitSync(readback.Fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1'000'000'000 : 0);
+	while (wait && result == GL_TIMEOUT_EXPIRED) {
+		result = glClientWaitSync(readback.Fence, 0, 1'000'000'000);
+	}
+
+	if (result == GL_TIMEOUT_EXPIRED) {
+		return false;
+	}
+
+	glDeleteSync(readback.Fence);
+	readback.Fence = nullptr;
+
+	if (result == GL_WAIT_FAILED) {
+		std::cerr << "FrameCapture: waiting for the readback of " << readback.Path << " failed" << std::endl;
+		return true;
+	}
+
+	Image image{ .Width = readback.Width, .Height = readback.Height, .Path = std::move(readback.Path) };
+	{
+		std::lock_guard lock(_mutex);
+		if (!_freePixels.empty()) {
+			image.Pixels = std::move(_freePixels.back());
+			_freePixels.pop_back();
+		}
+	}
+
+	//The only copy on this thread, the encoders convert and compress
+	image.Pixels.assign(readback.Mapped, readback.Mapped + static_cast<size_t>(readback.Width) * readback.Height * 4);
+
+	std::unique_lock lock(_mutex);
+	if (_images.size() >= MaxQueuedImages) {
+		_stats.EncoderWaits++;
+		_dequeued.wait(lock, [this]() { return _images.size() < MaxQueuedImages; });
+	}
+
+	_images.push_back(std::move(image));
+	lock.unlock();
+	_queued.notify_one();
+
+	return true;
+}
+
+void FrameCapture::encoderLoop() {
+	PROFILE_THREAD("Capture encoder");
+
+	while (true) {
+		Image image;
+		{
+			std::unique_lock lock(_mutex);
+			_queued.wait(lock, [this]() { return _stopping || !_images.empty(); });
+
+			if (_images.empty()) {
+				return;
+			}
+
+			image = std::move(_images.front());
+			_images.pop_front();
+		}
+		_dequeued.notify_one();
+
+		auto written = writeImage(image);
+
+		std::lock_guard lock(_mutex);
+		(written ? _stats.Written : _stats.Failed)++;
+
+		//Sequences keep capturing at the same size, their buffers are reused instead of reallocated
+		if (_freePixels.size() < MaxQueuedImages) {
+			_freePixels.push_back(std::move(image.Pixels));
+		}
+	}
+}
+
+bool FrameCapture::writeImage(Image& image) {
+	PROFILE_SCOPE("Encode image");
+
+	//GL rows start at the bottom, image files at the top
+	auto rowSize = static_cast<size_t>(image.Width) * 4;
+	auto* pixels = image.Pixels.data();
+	for (size_t y = 0; y < static_cast<size_t>(image.Height) / 2; y++) {
+		std::swap_ranges(pixels + y * rowSize, pixels + (y + 1) * rowSize, pixels + (image.Height - 1 - y) * rowSize);
+	}
+
+	//Alpha is dropped, the back buffer's is meaningless. RGB is never ahead of RGBA, so this works in place
+	auto pixelCount = static_cast<size_t>(image.Width) * image.Height;
+	for (size_t i = 0; i < pixelCount; i++) {
+		std::memmove(pixels + i * 3, pixels + i * 4, 3);
+	}
+
+	if (image.Path.has_parent_path()) {
+		std::error_code error;
+		std::filesystem::create_directories(image.Path.parent_path(), error);
+	}
+
+	std::ofstream out(image.Path, std::ios::binary);
+	if (!out) {
+		std::cerr << "FrameCapture: could not open " << image.Path << std::endl;
+		return false;
+	}
+
+	auto extension = image.Path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	auto result = extension == ".tga"
+		? stbi_write_tga_to_func(writeToStream, &out, image.Width, image.Height, 3, pixels)
+		: stbi_write_png_to_func(writeToStream, &out, image.Width, image.Height, 3, pixels, image.Width * 3);
+
+	return result != 0 && static_cast<bool>(out);
+}
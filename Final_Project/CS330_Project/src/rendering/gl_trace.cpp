@@ -0,0 +1,635 @@
+#include <rendering/gl_trace.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//Every entry point the renderer uses, calls through other pointers aren't counted
+#define GL_TRACE_ENTRY_POINTS(X) \
+	X(ActiveTexture) X(AttachShader) X(BindBuffer) X(BindBufferBase) X(BindBufferRange) X(BindFramebuffer) \
+	X(BindRenderbuffer) X(BindTexture) X(BindVertexArray) X(BindVertexBuffer) X(BlendFunc) X(BufferData) \
+	X(BufferStorage) X(BufferSubData) X(CheckFramebufferStatus) X(Clear) X(ClearBufferfi) X(ClearBufferfv) \
+	X(ClearColor) X(ClientWaitSync) X(ColorMask) X(CompileShader) X(CreateProgram) X(CreateShader) \
+	X(CullFace) X(DeleteBuffers) X(DeleteFramebuffers) X(DeleteProgram) X(DeleteQueries) \
+	X(DeleteRenderbuffers) X(DeleteShader) X(DeleteSync) X(DeleteTextures) X(DeleteVertexArrays) \
+	X(DepthFunc) X(DepthMask) X(Disable) X(DispatchCompute) X(DrawArrays) X(DrawArraysInstanced) \
+	X(DrawBuffer) X(DrawBuffers) X(DrawElements) X(DrawElementsInstanced) X(Enable) \
+	X(EnableVertexAttribArray) X(FenceSync) X(Flush) X(FramebufferRenderbuffer) X(FramebufferTexture2D) \
+	X(FrontFace) X(GenBuffers) X(GenerateMipmap) X(GenFramebuffers) X(GenQueries) X(GenRenderbuffers) \
+	X(GenTextures) X(GenVertexArrays) X(GetError) X(GetInteger64v) X(GetIntegerv) X(GetProgramInfoLog) \
+	X(GetProgramiv) X(GetQueryObjectiv) X(GetQueryObjectui64v) X(GetShaderInfoLog) X(GetShaderiv) \
+	X(GetUniformLocation) X(IsEnabled) X(LinkProgram) X(MapBufferRange) X(MemoryBarrier) \
+	X(MultiDrawElementsIndirect) X(PixelStorei) X(QueryCounter) X(ReadPixels) X(RenderbufferStorage) \
+	X(ShaderSource) X(TexImage2D) X(TexParameteri) X(TexStorage2D) X(TexSubImage2D) X(Uniform1f) \
+	X(Uniform1i) X(Uniform1ui) X(Uniform2fv) X(Uniform3fv) X(Uniform4fv) X(UniformMatrix4fv) \
+	X(UnmapBuffer) X(UseProgram) X(VertexAttribBinding) X(VertexAttribDivisor) X(VertexAttribFormat) \
+	X(VertexAttribIPointer) X(VertexAttribPointer) X(Viewport)
+
+namespace {
+	enum class Call : uint32_t {
+#define GL_TRACE_ENUM(name) name,
+		GL_TRACE_ENTRY_POINTS(GL_TRACE_ENUM)
+#undef GL_TRACE_ENUM
+		Count
+	};
+
+	constexpr auto CallCount = static_cast<size_t>(Call::Count);
+
+	const char* const callNames[] = {
+#define GL_TRACE_NAME(name) "gl" #name,
+		GL_TRACE_ENTRY_POINTS(GL_TRACE_NAME)
+#undef GL_TRACE_NAME
+	};
+
+	constexpr uint32_t MaxSubsystems = 16;
+
+	struct CallCounts {
+		uint32_t Calls{ 0 };
+		uint32_t Redundant{ 0 };
+	};
+
+	using SubsystemCounts = std::array<CallCounts, CallCount>;
+
+	bool installed{ false };
+
+	//Index 0 collects the calls outside of any scope
+	std::mutex subsystemsMutex;
+	std::array<const char*, MaxSubsystems> subsystemNames{ "Other" };
+	//Bumped after the name was written, the counting thread may read it while another registers
+	std::atomic<uint32_t> subsystemCount{ 1 };
+	thread_local uint32_t threadSubsystem{ 0 };
+
+	//Only the thread with the context current touches the counters and the shadow state
+	std::array<SubsystemCounts, MaxSubsystems> frameCounts{};
+
+	std::mutex requestMutex;
+	std::atomic<uint32_t> requestedFrames{ 0 };
+	std::filesystem::path requestedPath{};
+
+	struct FrameSummary {
+		uint32_t Calls{ 0 };
+		uint32_t Redundant{ 0 };
+		std::array<uint32_t, MaxSubsystems> SubsystemCalls{};
+	};
+
+	uint32_t captureFramesLeft{ 0 };
+	std::filesystem::path capturePath{};
+	std::vector<FrameSummary> captureFrames{};
+	std::array<std::array<uint64_t, CallCount>, MaxSubsystems> captureCalls{};
+	std::array<std::array<uint64_t, CallCount>, MaxSubsystems> captureRedundant{};
+
+	uint64_t key(uint32_t high, uint32_t low) {
+		return (static_cast<uint64_t>(high) << 32) | low;
+	}
+
+	struct BufferRange {
+		GLuint Buffer{ 0 };
+		GLintptr Offset{ 0 };
+		GLsizeiptr Size{ -1 };
+
+		bool operator==(const BufferRange&) const = default;
+	};
+
+	struct VertexBufferBinding {
+		GLuint Buffer{ 0 };
+		GLintptr Offset{ 0 };
+		GLsizei Stride{ 0 };
+
+		bool operator==(const VertexBufferBinding&) const = default;
+	};
+
+	struct UniformValue {
+		std::array<uint8_t, 64> Bytes{};
+		uint32_t Size{ 0 };
+	};
+
+	//What the context holds as far as the traced calls tell, a missing entry is still at GL's default
+	struct ShadowState {
+		GLuint Program{ 0 };
+		GLuint VertexArray{ 0 };
+		GLenum ActiveTexture{ GL_TEXTURE0 };
+		//generic bind points by target, the element array binding belongs to the vertex array
+		std::unordered_map<GLenum, GLuint> Buffers{};
+		std::unordered_map<GLuint, GLuint> ElementBuffers{};
+		//by target and index, missing means unknown rather than unbound
+		std::unordered_map<uint64_t, BufferRange> IndexedBuffers{};
+		//by vertex array and binding index, missing means unknown
+		std::unordered_map<uint64_t, VertexBufferBinding> VertexBuffers{};
+		//by texture unit and target
+		std::unordered_map<uint64_t, GLuint> Textures{};
+		//by texture and parameter
+		std::unordered_map<uint64_t, GLint> TextureParameters{};
+		std::unordered_map<GLenum, bool> Capabilities{};
+		//by program and location, cleared when the program is linked again
+		std::unordered_map<uint64_t, UniformValue> Uniforms{};
+		std::unordered_map<GLuint, std::unordered_set<std::string>> UniformNames{};
+		std::optional<std::array<GLint, 4>> Viewport{};
+		std::array<GLfloat, 4> ClearColor{};
+		std::array<GLenum, 2> BlendFunc{ GL_ONE, GL_ZERO };
+		GLenum CullFace{ GL_BACK };
+		GLenum FrontFace{ GL_CCW };
+	};
+
+	ShadowState shadow{};
+
+	//Stores value, true when the stored value already was value
+	template <typename T>
+	bool update(T& stored, const T& value) {
+		if (stored == value) {
+			return true;
+		}
+
+		stored = value;
+		return false;
+	}
+
+	template <typename Map, typename T>
+	bool update(Map& map, typename Map::key_type mapKey, const T& value, const T& defaultValue) {
+		auto [it, inserted] = map.try_emplace(mapKey, defaultValue);
+		return update(it->second, value);
+	}
+
+	template <typename Map, typename Predicate>
+	void eraseIf(Map& map, Predicate predicate) {
+		for (auto it = map.begin(); it != map.end();) {
+			it = predicate(*it) ? map.erase(it) : std::next(it);
+		}
+	}
+
+	GLint defaultTextureParameter(GLenum parameter) {
+		switch (parameter) {
+			case GL_TEXTURE_WRAP_S:
+			case GL_TEXTURE_WRAP_T:
+			case GL_TEXTURE_WRAP_R: return GL_REPEAT;
+			case GL_TEXTURE_MIN_FILTER: return GL_NEAREST_MIPMAP_LINEAR;
+			case GL_TEXTURE_MAG_FILTER: return GL_LINEAR;
+			default: return -1;
+		}
+	}
+
+	//Location -1 is ignored by GL, so the call is redundant too
+	bool updateUniform(GLint location, GLsizei count, const void* data, uint32_t size) {
+		if (location == -1) {
+			return true;
+		}
+
+		auto uniformKey = key(shadow.Program, static_cast<uint32_t>(location));
+		if (count != 1 || size > sizeof(UniformValue::Bytes)) {
+			shadow.Uniforms.erase(uniformKey);
+			return false;
+		}
+
+		auto& value = shadow.Uniforms[uniformKey];
+		if (value.Size == size && std::memcmp(value.Bytes.data(), data, size) == 0) {
+			return true;
+		}
+
+		value.Size = size;
+		std::memcpy(value.Bytes.data(), data, size);
+		return false;
+	}
+
+	void forgetProgram(GLuint program) {
+		eraseIf(shadow.Uniforms, [program](const auto& entry) { return entry.first >> 32 == program; });
+		shadow.UniformNames.erase(program);
+	}
+
+	//Updates the shadow state before the call goes to the driver, true when it changes nothing.
+	//Calls that don't touch tracked state keep the default
+	template <Call C>
+	struct Tracker {
+		template <typename... Args>
+		static bool Observe(Args...) { return false; }
+	};
+
+	template <> struct Tracker<Call::UseProgram> {
+		static bool Observe(GLuint program) { return update(shadow.Program, program); }
+	};
+
+	template <> struct Tracker<Call::LinkProgram> {
+		static bool Observe(GLuint program) { forgetProgram(program); return false; }
+	};
+
+	template <> struct Tracker<Call::DeleteProgram> {
+		static bool Observe(GLuint program) { forgetProgram(program); return program == 0; }
+	};
+
+	template <> struct Tracker<Call::GetUniformLocation> {
+		//The location only changes when the program is linked again, asking twice is driver work a cache saves
+		static bool Observe(GLuint program, const GLchar* name) { return !shadow.UniformNames[program].emplace(name).second; }
+	};
+
+	template <> struct Tracker<Call::BindVertexArray> {
+		static bool Observe(GLuint vertexArray) { return update(shadow.VertexArray, vertexArray); }
+	};
+
+	template <> struct Tracker<Call::DeleteVertexArrays> {
+		static bool Observe(GLsizei count, const GLuint* vertexArrays) {
+			for (auto i = 0; i < count; i++) {
+				auto vertexArray = vertexArrays[i];
+				shadow.ElementBuffers.erase(vertexArray);
+				eraseIf(shadow.VertexBuffers, [vertexArray](const auto& entry) { return entry.first >> 32 == vertexArray; });
+
+				if (shadow.VertexArray == vertexArray) {
+					shadow.VertexArray = 0;
+				}
+			}
+			return false;
+		}
+	};
+
+	template <> struct Tracker<Call::BindBuffer> {
+		static bool Observe(GLenum target, GLuint buffer) {
+			if (target == GL_ELEMENT_ARRAY_BUFFER) {
+				return update(shadow.ElementBuffers, shadow.VertexArray, buffer, 0u);
+			}
+			return update(shadow.Buffers, target, buffer, 0u);
+		}
+	};
+
+	//Binding a range also sets the generic bind point, the call only changes nothing when both match
+	bool updateIndexedBuffer(GLenum target, GLuint index, const BufferRange& range) {
+		auto generic = update(shadow.Buffers, target, range.Buffer, 0u);
+
+		auto [it, inserted] = shadow.IndexedBuffers.try_emplace(key(target, index), range);
+		auto indexed = !inserted && update(it->second, range);
+
+		return generic && indexed;
+	}
+
+	template <> struct Tracker<Call::BindBufferBase> {
+		static bool Observe(GLenum target, GLuint index, GLuint buffer) {
+			return updateIndexedBuffer(target, index, { .Buffer = buffer });
+		}
+	};
+
+	template <> struct Tracker<Call::BindBufferRange> {
+		static bool Observe(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+			return updateIndexedBuffer(target, index, { .Buffer = buffer, .Offset = offset, .Size = size });
+		}
+	};
+
+	template <> struct Tracker<Call::BindVertexBuffer> {
+		static bool Observe(GLuint index, GLuint buffer, GLintptr offset, GLsizei stride) {
+			VertexBufferBinding binding{ .Buffer = buffer, .Offset = offset, .Stride = stride };
+			auto [it, inserted] = shadow.VertexBuffers.try_emplace(key(shadow.VertexArray, index), binding);
+			return !inserted && update(it->second, binding);
+		}
+	};
+
+	template <> struct Tracker<Call::DeleteBuffers> {
+		//Deleting a bound buffer unbinds it from the bind points of this context
+		static bool Observe(GLsizei count, const GLuint* buffers) {
+			for (auto i = 0; i < count; i++) {
+				auto buffer = buffers[i];
+				for (auto& [target, bound] : shadow.Buffers) {
+					if (bound == buffer) {
+						bound = 0;
+					}
+				}
+
+				if (auto it = shadow.ElementBuffers.find(shadow.VertexArray); it != shadow.ElementBuffers.end() && it->second == buffer) {
+					it->second = 0;
+				}
+
+				eraseIf(shadow.IndexedBuffers, [buffer](const auto& entry) { return entry.second.Buffer == buffer; });
+				eraseIf(shadow.VertexBuffers, [buffer](const auto& entry) { return entry.second.Buffer == buffer; });
+			}
+			return false;
+		}
+	};
+
+	template <> struct Tracker<Call::ActiveTexture> {
+		static bool Observe(GLenum unit) { return update(shadow.ActiveTexture, unit); }
+	};
+
+	template <> struct Tracker<Call::BindTexture> {
+		static bool Observe(GLenum target, GLuint texture) {
+			return update(shadow.Textures, key(shadow.ActiveTexture, target), texture, 0u);
+		}
+	};
+
+	template <> struct Tracker<Call::TexParameteri> {
+		//Parameters belong to the texture, rebinding it doesn't reset them
+		static bool Observe(GLenum target, GLenum parameter, GLint value) {
+			auto texture = shadow.Textures[key(shadow.ActiveTexture, target)];
+			return update(shadow.TextureParameters, key(texture, parameter), value, defaultTextureParameter(parameter));
+		}
+	};
+
+	template <> struct Tracker<Call::DeleteTextures> {
+		static bool Observe(GLsizei count, const GLuint* textures) {
+			for (auto i = 0; i < count; i++) {
+				auto texture = textures[i];
+				for (auto& [unit, bound] : shadow.Textures) {
+					if (bound == texture) {
+						bound = 0;
+					}
+				}
+
+				eraseIf(shadow.TextureParameters, [texture](const auto& entry) { return entry.first >> 32 == texture; });
+			}
+			return false;
+		}
+	};
+
+	//Everything starts disabled except dithering and multisampling
+	bool updateCapability(GLenum capability, bool enabled) {
+		return update(shadow.Capabilities, capability, enabled, capability == GL_DITHER || capability == GL_MULTISAMPLE);
+	}
+
+	template <> struct Tracker<Call::Enable> {
+		static bool Observe(GLenum capability) { return updateCapability(capability, true); }
+	};
+
+	template <> struct Tracker<Call::Disable> {
+		static bool Observe(GLenum capability) { return updateCapability(capability, false); }
+	};
+
+	template <> struct Tracker<Call::Viewport> {
+		//The initial viewport is the window size, the first call is never redundant
+		static bool Observe(GLint x, GLint y, GLsizei width, GLsizei height) {
+			std::array<GLint, 4> viewport{ x, y, width, height };
+			auto unchanged = shadow.Viewport == viewport;
+			shadow.Viewport = viewport;
+			return unchanged;
+		}
+	};
+
+	template <> struct Tracker<Call::ClearColor> {
+		static bool Observe(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+			return update(shadow.ClearColor, std::array<GLfloat, 4>{ red, green, blue, alpha });
+		}
+	};
+
+	template <> struct Tracker<Call::BlendFunc> {
+		static bool Observe(GLenum source, GLenum destination) {
+			return update(shadow.BlendFunc, std::array<GLenum, 2>{ source, destination });
+		}
+	};
+
+	template <> struct Tracker<Call::CullFace> {
+		static bool Observe(GLenum mode) { return update(shadow.CullFace, mode); }
+	};
+
+	template <> struct Tracker<Call::FrontFace> {
+		//Invalid modes are rejected by GL and leave the state alone
+		static bool Observe(GLenum mode) {
+			if (mode != GL_CW && mode != GL_CCW) {
+				return false;
+			}
+			return update(shadow.FrontFace, mode);
+		}
+	};
+
+	template <> struct Tracker<Call::Uniform1i> {
+		static bool Observe(GLint location, GLint value) { return updateUniform(location, 1, &value, sizeof(value)); }
+	};
+
+	template <> struct Tracker<Call::Uniform1ui> {
+		static bool Observe(GLint location, GLuint value) { return updateUniform(location, 1, &value, sizeof(value)); }
+	};
+
+	template <> struct Tracker<Call::Uniform1f> {
+		static bool Observe(GLint location, GLfloat value) { return updateUniform(location, 1, &value, sizeof(value)); }
+	};
+
+	template <> struct Tracker<Call::Uniform2fv> {
+		static bool Observe(GLint location, GLsizei count, const GLfloat* value) { return updateUniform(location, count, value, 2 * sizeof(GLfloat)); }
+	};
+
+	template <> struct Tracker<Call::Uniform3fv> {
+		static bool Observe(GLint location, GLsizei count, const GLfloat* value) { return updateUniform(location, count, value, 3 * sizeof(GLfloat)); }
+	};
+
+	template <> struct Tracker<Call::Uniform4fv> {
+		static bool Observe(GLint location, GLsizei count, const GLfloat* value) { return updateUniform(location, count, value, 4 * sizeof(GLfloat)); }
+	};
+
+	template <> struct Tracker<Call::UniformMatrix4fv> {
+		//Transposed uploads store different bytes for the same matrix, the flag isn't part of the value
+		static bool Observe(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+			return !transpose && updateUniform(location, count, value, 16 * sizeof(GLfloat));
+		}
+	};
+
+	//Stands in for one glad pointer: counts the call, then forwards it to the driver's entry point
+	template <Call C, typename Proc>
+	struct Hook;
+
+	template <Call C, typename R, typename... Args>
+	struct Hook<C, R(APIENTRYP)(Args...)> {
+		static inline R(APIENTRYP Original)(Args...) = nullptr;
+
+		static R APIENTRY Forward(Args... args) {
+			auto& counts = frameCounts[threadSubsystem][static_cast<size_t>(C)];
+			counts.Calls++;
+			counts.Redundant += Tracker<C>::Observe(args...) ? 1 : 0;
+
+			return Original(args...);
+		}
+	};
+
+	void writeReport(const std::filesystem::path& path) {
+		std::ofstream out(path);
+		if (!out) {
+			std::cerr << "GlTrace: could not open " << path << std::endl;
+			return;
+		}
+
+		auto frameCount = static_cast<double>(captureFrames.size());
+
+		out << "GL calls of " << captureFrames.size() << " frames\n\n";
+		out << std::left << std::setw(8) << "frame" << std::setw(10) << "calls" << std::setw(12) << "redundant";
+		for (uint32_t s = 0; s < subsystemCount; s++) {
+			out << std::setw(14) << subsystemNames[s];
+		}
+		out << "\n";
+
+		for (size_t f = 0; f < captureFrames.size(); f++) {
+			const auto& frame = captureFrames[f];
+			out << std::setw(8) << f << std::setw(10) << frame.Calls << std::setw(12) << frame.Redundant;
+			for (uint32_t s = 0; s < subsystemCount; s++) {
+				out << std::setw(14) << frame.SubsystemCalls[s];
+			}
+			out << "\n";
+		}
+
+		//Entry points by calls per frame, with the subsystems that make them
+		std::vector<size_t> calls(CallCount);
+		std::vector<uint64_t> callTotals(CallCount);
+		std::vector<uint64_t> redundantTotals(CallCount);
+		for (size_t c = 0; c < CallCount; c++) {
+			calls[c] = c;
+			for (uint32_t s = 0; s < subsystemCount; s++) {
+				callTotals[c] += captureCalls[s][c];
+				redundantTotals[c] += captureRedundant[s][c];
+			}
+		}
+		std::sort(calls.begin(), calls.end(), [&callTotals](size_t a, size_t b) { return callTotals[a] > callTotals[b]; });
+
+		out << "\nentry points, per frame\n" << std::fixed << std::setprecision(1);
+		for (auto c : calls) {
+			if (callTotals[c] == 0) {
+				break;
+			}
+
+			out << "  " << std::setw(28) << callNames[c] << std::right << std::setw(10) << callTotals[c] / frameCount
+				<< " calls" << std::setw(10) << redundantTotals[c] / frameCount << " redundant " << std::left;
+			for (uint32_t s = 0; s < subsystemCount; s++) {
+				if (captureCalls[s][c] > 0) {
+					out << " " << subsystemNames[s] << " " << captureCalls[s][c] / frameCount;
+				}
+			}
+			out << "\n";
+		}
+
+		std::cerr << "gl trace: wrote " << captureFrames.size() << " frames to " << path << std::endl;
+	}
+
+	void printTopRedundant(size_t count) {
+		struct Entry {
+			size_t Call;
+			uint32_t Subsystem;
+			uint64_t Redundant;
+		};
+
+		std::vector<Entry> entries;
+		for (uint32_t s = 0; s < subsystemCount; s++) {
+			for (size_t c = 0; c < CallCount; c++) {
+				if (captureRedundant[s][c] > 0) {
+					entries.push_back({ c, s, captureRedundant[s][c] });
+				}
+			}
+		}
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.Redundant > b.Redundant; });
+
+		uint64_t totalCalls = 0;
+		uint64_t totalRedundant = 0;
+		for (const auto& frame : captureFrames) {
+			totalCalls += frame.Calls;
+			totalRedundant += frame.Redundant;
+		}
+
+		auto frameCount = static_cast<double>(captureFrames.size());
+		std::cerr << std::fixed << std::setprecision(1)
+			<< "gl trace: " << totalCalls / frameCount << " calls per frame, " << totalRedundant / frameCount << " redundant" << std::endl;
+
+		for (size_t i = 0; i < std::min(count, entries.size()); i++) {
+			const auto& entry = entries[i];
+			std::cerr << "  " << callNames[entry.Call] << " (" << subsystemNames[entry.Subsystem] << "): "
+				<< entry.Redundant / frameCount << " redundant of "
+				<< captureCalls[entry.Subsystem][entry.Call] / frameCount << " per frame" << std::endl;
+		}
+		std::cerr << std::defaultfloat;
+	}
+}
+
+void GlTrace::Install() {
+	if (installed) {
+		return;
+	}
+
+	//Entry points the driver doesn't have stay null
+#define GL_TRACE_INSTALL(name) \
+	if (glad_gl##name) { \
+		using HookType = Hook<Call::name, decltype(glad_gl##name)>; \
+		HookType::Original = glad_gl##name; \
+		glad_gl##name = &HookType::Forward; \
+	}
+	GL_TRACE_ENTRY_POINTS(GL_TRACE_INSTALL)
+#undef GL_TRACE_INSTALL
+
+	installed = true;
+	std::cerr << "gl trace: " << CallCount << " entry points wrapped" << std::endl;
+}
+
+bool GlTrace::IsInstalled() {
+	return installed;
+}
+
+void GlTrace::BeginCapture(uint32_t frameCount, const std::filesystem::path& path) {
+	if (!installed) {
+		std::cerr << "GlTrace: not installed, build with CS330_GL_TRACE" << std::endl;
+		return;
+	}
+
+	std::lock_guard lock(requestMutex);
+	requestedPath = path;
+	requestedFrames.store(frameCount, std::memory_order_release);
+}
+
+void GlTrace::EndFrame() {
+	if (!installed) {
+		return;
+	}
+
+	if (captureFramesLeft > 0) {
+		FrameSummary summary{};
+		for (uint32_t s = 0; s < subsystemCount; s++) {
+			for (size_t c = 0; c < CallCount; c++) {
+				const auto& counts = frameCounts[s][c];
+				summary.Calls += counts.Calls;
+				summary.Redundant += counts.Redundant;
+				summary.SubsystemCalls[s] += counts.Calls;
+				captureCalls[s][c] += counts.Calls;
+				captureRedundant[s][c] += counts.Redundant;
+			}
+		}
+		captureFrames.push_back(summary);
+
+		if (--captureFramesLeft == 0) {
+			writeReport(capturePath);
+			printTopRedundant(10);
+		}
+	}
+	else if (requestedFrames.load(std::memory_order_acquire) > 0) {
+		//Starts with the next frame, this one was partly counted before the request
+		std::lock_guard lock(requestMutex);
+		captureFramesLeft = requestedFrames.exchange(0);
+		capturePath = requestedPath;
+		captureFrames.clear();
+		captureFrames.reserve(captureFramesLeft);
+		captureCalls = {};
+		captureRedundant = {};
+		std::cerr << "gl trace: capturing " << captureFramesLeft << " frames" << std::endl;
+	}
+
+	std::fill(frameCounts.begin(), frameCounts.begin() + subsystemCount, SubsystemCounts{});
+}
+
+uint32_t GlTrace::RegisterSubsystem(const char* name) {
+	std::lock_guard lock(subsystemsMutex);
+	for (uint32_t i = 0; i < subsystemCount; i++) {
+		if (std::strcmp(subsystemNames[i], name) == 0) {
+			return i;
+		}
+	}
+
+	if (subsystemCount == MaxSubsystems) {
+		std::cerr << "GlTrace: too many subsystems, " << name << " counts as " << subsystemNames[0] << std::endl;
+		return 0;
+	}
+
+	subsystemNames[subsystemCount] = name;
+	return subsystemCount++;
+}
+
+GlTraceScope::GlTraceScope(uint32_t subsystem)
+	: _previous{ threadSubsystem } {
+	threadSubsystem = subsystem;
+}
+
+GlTraceScope::~GlTraceScope() {
+	threadSubsystem = _previous;
+}
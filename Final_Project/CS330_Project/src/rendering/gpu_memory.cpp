@@ -0,0 +1,38 @@
+#include <rendering/gpu_memory.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+	//Allocations happen on the main and the render thread, the totals are read every frame
+	std::mutex sizesMutex;
+	std::unordered_map<uint64_t, int64_t> sizes;
+	std::atomic<int64_t> totals[3]{};
+
+	uint64_t keyOf(GpuMemory::Kind kind, GLuint name) {
+		return (static_cast<uint64_t>(kind) << 32) | name;
+	}
+}
+
+void GpuMemory::Track(Kind kind, GLuint name, int64_t bytes) {
+	std::lock_guard lock(sizesMutex);
+	auto& size = sizes[keyOf(kind, name)];
+
+	totals[static_cast<size_t>(kind)].fetch_add(bytes - size, std::memory_order_relaxed);
+	size = bytes;
+}
+
+void GpuMemory::Forget(Kind kind, GLuint name) {
+	std::lock_guard lock(sizesMutex);
+	auto it = sizes.find(keyOf(kind, name));
+	if (it == sizes.end()) {
+		return;
+	}
+
+	totals[static_cast<size_t>(kind)].fetch_sub(it->second, std::memory_order_relaxed);
+	sizes.erase(it);
+}
+
+int64_t GpuMemory::GetTotal(Kind kind) {
+	return totals[static_cast<size_t>(kind)].load(std::memory_order_relaxed);
+}
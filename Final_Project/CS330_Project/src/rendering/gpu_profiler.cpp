@@ -0,0 +1,122 @@
+#include <rendering/gpu_profiler.h>
+#include <rendering/gl_trace.h>
+
+GpuProfiler::~GpuProfiler() {
+	Release();
+}
+
+bool GpuProfiler::Init() {
+	for (auto& frame : _frames) {
+		glGenQueries(static_cast<GLsizei>(frame.Queries.size()), frame.Queries.data());
+		frame.Zones.reserve(MaxZones);
+	}
+
+	if (!_track) {
+		_track = Profiler::CreateTrack("GPU");
+	}
+
+	_initialized = true;
+	return glGetError() == GL_NO_ERROR;
+}
+
+void GpuProfiler::Release() {
+	if (!_initialized) {
+		return;
+	}
+
+	for (auto& frame : _frames) {
+		glDeleteQueries(static_cast<GLsizei>(frame.Queries.size()), frame.Queries.data());
+		frame.Zones.clear();
+		frame.Pending = false;
+	}
+
+	_current = nullptr;
+	_initialized = false;
+}
+
+void GpuProfiler::BeginFrame() {
+	if (!_initialized) {
+		return;
+	}
+	GL_TRACE_SCOPE("GPU profiler");
+
+	auto& frame = _frames[_frameIndex % FrameLatency];
+	_frameIndex++;
+
+	if (frame.Pending) {
+		collect(frame);
+	}
+
+	auto recording = Profiler::IsRecording();
+	if (recording && !_wasRecording) {
+		calibrate();
+	}
+	_wasRecording = recording;
+
+	_current = recording ? &frame : nullptr;
+	_depth = 0;
+}
+
+void GpuProfiler::EndFrame() {
+	if (_current) {
+		_current->Pending = !_current->Zones.empty();
+	}
+	_current = nullptr;
+}
+
+uint32_t GpuProfiler::BeginZone(const char* name) {
+	if (!_current || _current->Zones.size() == MaxZones) {
+		return NoZone;
+	}
+
+	auto zone = static_cast<uint32_t>(_current->Zones.size());
+	_current->Zones.push_back({ .Name = name, .Depth = _depth++ });
+	_current->LastQuery = _current->Queries[zone * 2];
+	glQueryCounter(_current->LastQuery, GL_TIMESTAMP);
+
+	return zone;
+}
+
+void GpuProfiler::EndZone(uint32_t zone) {
+	if (zone == NoZone || !_current) {
+		return;
+	}
+
+	_current->LastQuery = _current->Queries[zone * 2 + 1];
+	glQueryCounter(_current->LastQuery, GL_TIMESTAMP);
+	_depth--;
+}
+
+void GpuProfiler::collect(FrameQueries& frame) {
+	frame.Pending = false;
+
+	//Results come in order, the timestamp issued last being ready means all of them are. Otherwise the
+	//frame is dropped rather than waited for
+	GLint available = 0;
+	glGetQueryObjectiv(frame.LastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+
+	if (available) {
+		for (uint32_t zone = 0; zone < frame.Zones.size(); zone++) {
+			GLuint64 begin = 0;
+			GLuint64 end = 0;
+			glGetQueryObjectui64v(frame.Queries[zone * 2], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(frame.Queries[zone * 2 + 1], GL_QUERY_RESULT, &end);
+
+			Profiler::Record(*_track, {
+				.Name = frame.Zones[zone].Name,
+				.Start = static_cast<int64_t>(begin) + _clockOffset,
+				.Duration = static_cast<int64_t>(end - begin),
+				.Depth = frame.Zones[zone].Depth
+			});
+		}
+	}
+
+	frame.Zones.clear();
+}
+
+void GpuProfiler::calibrate() {
+	//GL time of the moment the commands so far reached the GPU, close enough to line the tracks up
+	GLint64 gpuTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+	_clockOffset = Profiler::Now() - gpuTime;
+}
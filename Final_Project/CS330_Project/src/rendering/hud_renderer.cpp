@@ -0,0 +1,105 @@
+#include <rendering/hud_renderer.h>
+#include <rendering/gpu_memory.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+	//HUD units to pixels, stb_easy_font glyphs are about 7 units tall
+	constexpr float HUD_SCALE = 2.f;
+}
+
+HudRenderer::~HudRenderer() {
+	Release();
+}
+
+bool HudRenderer::Init() {
+	_shader = std::make_unique<Shader>(Shader::ShaderPath / "hud.vert", Shader::ShaderPath / "hud.frag");
+
+	//Two triangles per quad, stb_easy_font writes the corners in order around the quad
+	std::vector<uint16_t> indices;
+	indices.reserve(MaxQuads * 6);
+	for (uint32_t quad = 0; quad < MaxQuads; quad++) {
+		auto first = static_cast<uint16_t>(quad * 4);
+		for (auto corner : { 0, 1, 2, 0, 2, 3 }) {
+			indices.push_back(static_cast<uint16_t>(first + corner));
+		}
+	}
+
+	glGenVertexArrays(1, &_vertexArray);
+	glGenBuffers(1, &_indexBuffer);
+
+	glBindVertexArray(_vertexArray);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _indexBuffer, indices.size() * sizeof(uint16_t));
+
+	//The vertex buffer and its offset change every frame, only the format is fixed
+	glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, offsetof(HudVertex, X));
+	glVertexAttribFormat(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(HudVertex, Color));
+	glVertexAttribBinding(0, 0);
+	glVertexAttribBinding(1, 0);
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+
+	glBindVertexArray(0);
+
+	return _shader->GetHandle() != 0;
+}
+
+void HudRenderer::Release() {
+	_shader.reset();
+
+	if (_vertexArray) {
+		glDeleteVertexArrays(1, &_vertexArray);
+		_vertexArray = 0;
+	}
+
+	if (_indexBuffer) {
+		GpuMemory::Forget(GpuMemory::Kind::Buffer, _indexBuffer);
+		glDeleteBuffers(1, &_indexBuffer);
+		_indexBuffer = 0;
+	}
+}
+
+GLsizeiptr HudRenderer::GetStreamSize(const std::vector<HudVertex>& vertices) {
+	//Plus room to align the start
+	return vertices.empty() ? 0 : static_cast<GLsizeiptr>(vertices.size() * sizeof(HudVertex) + sizeof(HudVertex));
+}
+
+void HudRenderer::Draw(const std::vector<HudVertex>& vertices, int width, int height, StreamBuffer& streamBuffer) {
+	auto quadCount = std::min(static_cast<uint32_t>(vertices.size() / 4), MaxQuads);
+	if (quadCount == 0 || !_shader) {
+		return;
+	}
+
+	auto size = static_cast<GLsizeiptr>(quadCount * 4 * sizeof(HudVertex));
+	auto allocation = streamBuffer.Allocate(size, sizeof(HudVertex));
+	if (!allocation.Data) {
+		std::cerr << "HudRenderer: no stream buffer space, overlay skipped" << std::endl;
+		return;
+	}
+	std::memcpy(allocation.Data, vertices.data(), size);
+
+	auto depthTest = glIsEnabled(GL_DEPTH_TEST);
+	auto blend = glIsEnabled(GL_BLEND);
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	_shader->Bind();
+	_shader->SetVec2("screenSize", glm::vec2(width, height));
+	_shader->SetFloat("scale", HUD_SCALE);
+
+	glBindVertexArray(_vertexArray);
+	glBindVertexBuffer(0, streamBuffer.GetHandle(), allocation.Offset, sizeof(HudVertex));
+	glDrawElements(GL_TRIANGLES, quadCount * 6, GL_UNSIGNED_SHORT, nullptr);
+	glBindVertexArray(0);
+
+	if (depthTest) {
+		glEnable(GL_DEPTH_TEST);
+	}
+	if (!blend) {
+		glDisable(GL_BLEND);
+	}
+}
@@ -0,0 +1,313 @@
+#include <rendering/indirect_renderer.h>
+#include <rendering/gpu_memory.h>
+#include <rendering/mesh.h>
+#include <rendering/texture.h>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <tuple>
+
+namespace {
+	//DrawElementsIndirectCommand
+	struct DrawCommand {
+		uint32_t Count;
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t BaseVertex;
+		uint32_t BaseInstance;
+	};
+
+	constexpr GLuint OBJECT_STORAGE_BINDING = 0;
+	constexpr GLuint MESH_STORAGE_BINDING = 1;
+	constexpr GLuint COMMAND_STORAGE_BINDING = 2;
+	constexpr GLuint CULL_GROUP_SIZE = 64;
+
+	//Gribb/Hartmann: planes from the rows of the view projection matrix, normals point inwards
+	std::array<glm::vec4, 6> frustumPlanes(const glm::mat4& viewProjection) {
+		auto m = glm::transpose(viewProjection);
+		return { m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2] };
+	}
+}
+
+IndirectRenderer::~IndirectRenderer() {
+	Release();
+}
+
+bool IndirectRenderer::Init() {
+	_cullShader = std::make_unique<Shader>(Shader::ShaderPath / "gpu_cull.comp");
+
+	glGenVertexArrays(1, &_vertexArray);
+	glGenBuffers(1, &_vertexBuffer);
+	glGenBuffers(1, &_indexBuffer);
+	glGenBuffers(1, &_objectIndexBuffer);
+	glGenBuffers(1, &_objectBuffer);
+	glGenBuffers(1, &_meshBuffer);
+	glGenBuffers(1, &_commandBuffer);
+
+	//Same attributes as Mesh, plus the object index advancing once per instance
+	glBindVertexArray(_vertexArray);
+	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Color));
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Uv));
+
+	glBindBuffer(GL_ARRAY_BUFFER, _objectIndexBuffer);
+	glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, sizeof(uint32_t), nullptr);
+	glVertexAttribDivisor(4, 1);
+
+	for (GLuint attribute = 0; attribute <= 4; attribute++) {
+		glEnableVertexAttribArray(attribute);
+	}
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+	glBindVertexArray(0);
+
+	return _cullShader->GetHandle() != 0;
+}
+
+void IndirectRenderer::Release() {
+	_cullShader.reset();
+	_programs.clear();
+
+	if (_vertexArray) {
+		glDeleteVertexArrays(1, &_vertexArray);
+	}
+
+	for (auto* buffer : { &_vertexBuffer, &_indexBuffer, &_objectIndexBuffer, &_objectBuffer, &_meshBuffer, &_commandBuffer }) {
+		if (*buffer) {
+			GpuMemory::Forget(GpuMemory::Kind::Buffer, *buffer);
+			glDeleteBuffers(1, buffer);
+			*buffer = 0;
+		}
+	}
+
+	_vertexArray = 0;
+	_vertices.clear();
+	_indices.clear();
+	_meshIndices.clear();
+	_meshes.clear();
+	_objectData.clear();
+	_slotOfObject.clear();
+	_groups.clear();
+	_triangleCount = 0;
+}
+
+void IndirectRenderer::Apply(const GpuSceneUpdate& update, const std::vector<Material>& materials) {
+	if (update.Rebuild) {
+		rebuild(update.Objects, materials);
+		return;
+	}
+
+	if (update.Slots.empty()) {
+		return;
+	}
+
+	//Only transforms and bounds change between rebuilds
+	auto firstSlot = std::numeric_limits<uint32_t>::max();
+	uint32_t lastSlot = 0;
+
+	for (size_t i = 0; i < update.Slots.size(); i++) {
+		if (update.Slots[i] >= _slotOfObject.size()) {
+			std::cerr << "IndirectRenderer: update for unknown object " << update.Slots[i] << std::endl;
+			continue;
+		}
+
+		auto slot = _slotOfObject[update.Slots[i]];
+		const auto& object = update.Objects[i];
+
+		auto& data = _objectData[slot];
+		data.Model = object.Model;
+		data.BoundsMin = glm::vec4(object.Bounds.Min, 1.f);
+		data.BoundsMax = glm::vec4(object.Bounds.Max, 1.f);
+
+		firstSlot = std::min(firstSlot, slot);
+		lastSlot = std::max(lastSlot, slot);
+	}
+
+	if (firstSlot > lastSlot) {
+		return;
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, _objectBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, firstSlot * sizeof(ObjectData), (lastSlot - firstSlot + 1) * sizeof(ObjectData), &_objectData[firstSlot]);
+}
+
+void IndirectRenderer::rebuild(const std::vector<GpuObjectRecord>& objects, const std::vector<Material>& materials) {
+	auto objectCount = static_cast<uint32_t>(objects.size());
+
+	//Program and textures of every object, groups numbered in order of first use
+	std::map<std::tuple<Shader*, Texture*, Texture*>, uint32_t> groupOfMaterial;
+	std::vector<uint32_t> objectGroups(objectCount);
+	_groups.clear();
+
+	for (uint32_t i = 0; i < objectCount; i++) {
+		const auto& material = materials[objects[i].Material];
+		auto* program = programFor(material.Program);
+		auto key = std::make_tuple(program, material.Textures[0], material.Textures[1]);
+
+		auto [it, inserted] = groupOfMaterial.try_emplace(key, static_cast<uint32_t>(_groups.size()));
+		if (inserted) {
+			_groups.push_back({ .Program = program, .Textures = material.Textures });
+		}
+
+		objectGroups[i] = it->second;
+		_groups[it->second].SlotCount++;
+	}
+
+	for (size_t group = 1; group < _groups.size(); group++) {
+		_groups[group].FirstSlot = _groups[group - 1].FirstSlot + _groups[group - 1].SlotCount;
+	}
+
+	//Counting sort into material order
+	std::vector<uint32_t> nextSlot(_groups.size());
+	for (size_t group = 0; group < _groups.size(); group++) {
+		nextSlot[group] = _groups[group].FirstSlot;
+	}
+
+	_objectData.assign(objectCount, {});
+	_slotOfObject.resize(objectCount);
+
+	for (uint32_t i = 0; i < objectCount; i++) {
+		auto slot = nextSlot[objectGroups[i]]++;
+		_slotOfObject[i] = slot;
+
+		auto& data = _objectData[slot];
+		data.Model = objects[i].Model;
+		data.BoundsMin = glm::vec4(objects[i].Bounds.Min, 1.f);
+		data.BoundsMax = glm::vec4(objects[i].Bounds.Max, 1.f);
+		data.Mesh = addMesh(objects[i].Geometry);
+		data.Material = objects[i].Material;
+	}
+
+	if (_geometryDirty) {
+		uploadGeometry();
+	}
+
+	std::vector<uint32_t> objectIndices(objectCount);
+	std::iota(objectIndices.begin(), objectIndices.end(), 0u);
+
+	glBindBuffer(GL_ARRAY_BUFFER, _objectIndexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, objectIndices.size() * sizeof(uint32_t), objectIndices.data(), GL_STATIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _objectIndexBuffer, objectIndices.size() * sizeof(uint32_t));
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, _objectBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, _objectData.size() * sizeof(ObjectData), _objectData.data(), GL_DYNAMIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _objectBuffer, _objectData.size() * sizeof(ObjectData));
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, _commandBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, objectCount * sizeof(DrawCommand), nullptr, GL_DYNAMIC_COPY);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _commandBuffer, objectCount * sizeof(DrawCommand));
+
+	//Before culling, the CPU doesn't see what the compute shader drops
+	_triangleCount = 0;
+	for (const auto& data : _objectData) {
+		_triangleCount += _meshes[data.Mesh].IndexCount / 3;
+	}
+}
+
+uint32_t IndirectRenderer::addMesh(const Mesh* mesh) {
+	auto [it, inserted] = _meshIndices.try_emplace(mesh, static_cast<uint32_t>(_meshes.size()));
+	if (!inserted) {
+		return it->second;
+	}
+
+	const auto& vertices = mesh->GetVertices();
+	const auto& elements = mesh->GetElements();
+
+	_meshes.push_back({
+		.IndexCount = static_cast<uint32_t>(elements.size()),
+		.FirstIndex = static_cast<uint32_t>(_indices.size()),
+		.BaseVertex = static_cast<int32_t>(_vertices.size())
+	});
+
+	_vertices.insert(_vertices.end(), vertices.begin(), vertices.end());
+	_indices.insert(_indices.end(), elements.begin(), elements.end());
+	_geometryDirty = true;
+
+	return it->second;
+}
+
+Shader* IndirectRenderer::programFor(const Shader* source) {
+	auto fragmentPath = source && !source->GetFragmentPath().empty() ? source->GetFragmentPath() : Shader::ShaderPath / "basic_lit.frag";
+
+	auto& program = _programs[fragmentPath.string()];
+	if (!program) {
+		program = std::make_unique<Shader>(Shader::ShaderPath / "indirect.vert", fragmentPath);
+	}
+
+	return program.get();
+}
+
+void IndirectRenderer::uploadGeometry() {
+	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), _vertices.data(), GL_STATIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _vertexBuffer, _vertices.size() * sizeof(Vertex));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(uint32_t), _indices.data(), GL_STATIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _indexBuffer, _indices.size() * sizeof(uint32_t));
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, _meshBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, _meshes.size() * sizeof(MeshData), _meshes.data(), GL_STATIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _meshBuffer, _meshes.size() * sizeof(MeshData));
+
+	_geometryDirty = false;
+}
+
+void IndirectRenderer::Cull(const glm::mat4& viewProjection, RenderStats& stats) {
+	auto objectCount = GetObjectCount();
+	if (objectCount == 0) {
+		return;
+	}
+
+	//One invocation per object writes its draw command
+	_cullShader->Bind();
+	auto planes = frustumPlanes(viewProjection);
+	for (uint32_t i = 0; i < planes.size(); i++) {
+		_cullShader->SetVec4("frustumPlanes[" + std::to_string(i) + "]", planes[i]);
+	}
+	_cullShader->SetUint("objectCount", objectCount);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_STORAGE_BINDING, _objectBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MESH_STORAGE_BINDING, _meshBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_STORAGE_BINDING, _commandBuffer);
+
+	glDispatchCompute((objectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+	stats.ProgramBinds++;
+}
+
+void IndirectRenderer::Draw(RenderStats& stats) {
+	if (GetObjectCount() == 0) {
+		return;
+	}
+
+	//Cull bound it too, but other passes may have run in between
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_STORAGE_BINDING, _objectBuffer);
+
+	//One multi draw per material, baseInstance picks the object in indirect.vert
+	glBindVertexArray(_vertexArray);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer);
+
+	for (const auto& group : _groups) {
+		group.Program->Bind();
+
+		for (uint32_t i = 0; i < group.Textures.size(); i++) {
+			if (group.Textures[i]) {
+				glActiveTexture(GL_TEXTURE0 + i);
+				group.Textures[i]->Bind();
+				stats.TextureBinds++;
+			}
+		}
+
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)(group.FirstSlot * sizeof(DrawCommand)), group.SlotCount, 0);
+	}
+
+	stats.ProgramBinds += static_cast<uint32_t>(_groups.size());
+	stats.DrawCalls += static_cast<uint32_t>(_groups.size());
+	stats.Triangles += _triangleCount;
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
@@ -0,0 +1,13 @@
+#include <rendering/material.h>
+
+MaterialId MaterialLibrary::Add(const Material& material) {
+	_materials.push_back(material);
+	_version++;
+
+	return static_cast<MaterialId>(_materials.size() - 1);
+}
+
+void MaterialLibrary::Set(MaterialId id, const Material& material) {
+	_materials[id] = material;
+	_version++;
+}
@@ -1,63 +1,147 @@
-#include <mesh.h>
-#include <iostream> 
-#include <core/shapes.h>
-
-Mesh::Mesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &elements)
-{
-    init(vertices, elements);
-}
-
-Mesh::Mesh(std::vector<Vertex> &vertices, std::vector<uint32_t>& elements, const glm::vec3 &color) {
-    for (auto& vertex : vertices) {
-        vertex.Color = color;
-    }
-
-    init(vertices, elements);
-}
-
-void Mesh::Draw() const {
-    //ind vertex array 
-    glBindVertexArray(_vertexArrayObject);
-
-    // Draw mesh elements
-    glDrawElements(GL_TRIANGLES, _elementCount, GL_UNSIGNED_INT, nullptr);
-}
-
-void Mesh::init(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements) {
-    // Auto-generate Normals: Could be added manually in shapes.h
-    // but better auto generated because of complex shapes
-    
-    for (auto i = 0; i < elements.size(); i += 3) {
-        auto p1Index = elements[i];
-        auto p2Index = elements[i + 1];
-        auto p3Index = elements[i + 2];
-
-        Shapes::UpdateNormals(vertices[p1Index], vertices[p2Index], vertices[p3Index]);
-    }
-
-    // Generate and Bind Buffers(vertex and elements) and Vertex Array Objects
-    glGenVertexArrays(1, &_vertexArrayObject);
-    glGenBuffers(1, &_vertexBufferObject);
-    glGenBuffers(1, &_elementBufferObject);
-
-    glBindVertexArray(_vertexArrayObject);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexBufferObject);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)), vertices.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _elementBufferObject);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(elements.size() * sizeof(uint32_t)), elements.data(), GL_STATIC_DRAW);
-
-
-    //Define vertex attribute for each channel/attribute in Vertex struct
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Color));
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Uv));
-
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-    glEnableVertexAttribArray(2);
-    glEnableVertexAttribArray(3);
-
-    _elementCount = elements.size();
-}
+#include <mesh.h>
+#include <rendering/gpu_memory.h>
+#include <iostream> 
+#include <glm/gtc/packing.hpp>
+#include <cmath>
+#include <limits>
+
+namespace {
+    uint32_t packColor(const glm::vec3& color) {
+        return glm::packUnorm4x8(glm::vec4(color, 1.f));
+    }
+
+    //x in the low bits, the layout GL_INT_2_10_10_10_REV reads
+    uint32_t packNormal(const glm::vec3& normal) {
+        auto length = glm::length(normal);
+        return glm::packSnorm3x10_1x2(glm::vec4(length > 0.f ? normal / length : normal, 0.f));
+    }
+
+    void packUv(const glm::vec2& uv, uint16_t (&packed)[2]) {
+        packed[0] = glm::packHalf1x16(uv.x);
+        packed[1] = glm::packHalf1x16(uv.y);
+    }
+
+    template <typename T>
+    GLsizeiptr uploadBuffer(GLenum target, GLuint buffer, const std::vector<T>& data) {
+        auto size = static_cast<GLsizeiptr>(data.size() * sizeof(T));
+        glBufferData(target, size, data.data(), GL_STATIC_DRAW);
+        GpuMemory::Track(GpuMemory::Kind::Buffer, buffer, size);
+        return size;
+    }
+}
+
+Mesh::Mesh(std::span<const Vertex> vertices, std::span<const uint32_t> elements, VertexFormat format, const MeshProcessingOptions& processing) :
+    _format {format}
+{
+    init({ vertices.begin(), vertices.end() }, { elements.begin(), elements.end() }, processing);
+}
+
+void Mesh::Draw() const {
+    //ind vertex array 
+    glBindVertexArray(_vertexArrayObject);
+
+    // Draw mesh elements
+    glDrawElements(GL_TRIANGLES, _elementCount, _indexType, nullptr);
+}
+
+void Mesh::init(std::vector<Vertex> vertices, std::vector<uint32_t> elements, const MeshProcessingOptions& processing) {
+    //Weld, generate missing normals and reorder for the vertex cache on our own copy, the shape data stays untouched
+    _vertices = std::move(vertices);
+    _elements = std::move(elements);
+    _processingStats = ProcessMesh(_vertices, _elements, processing);
+
+    for (const auto& vertex : _vertices) {
+        _bounds.Expand(vertex.Position);
+    }
+
+    // Generate and Bind Buffers(vertex and elements) and Vertex Array Objects
+    glGenVertexArrays(1, &_vertexArrayObject);
+    glGenBuffers(1, &_vertexBufferObject);
+    glGenBuffers(1, &_elementBufferObject);
+
+    glBindVertexArray(_vertexArrayObject);
+    uploadVertices();
+    uploadElements();
+
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glEnableVertexAttribArray(3);
+
+    _elementCount = static_cast<uint32_t>(_elements.size());
+}
+
+void Mesh::uploadVertices() {
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexBufferObject);
+
+    //Define vertex attribute for each channel/attribute in the chosen layout, the shaders read them all as floats
+    switch (_format) {
+        case VertexFormat::Float: {
+            _gpuBytes += uploadBuffer(GL_ARRAY_BUFFER, _vertexBufferObject, _vertices);
+
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Color));
+            glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+            glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Uv));
+            break;
+        }
+        case VertexFormat::Compact: {
+            std::vector<CompactVertex> packed(_vertices.size());
+            for (size_t i = 0; i < _vertices.size(); i++) {
+                packed[i].Position = _vertices[i].Position;
+                packed[i].Color = packColor(_vertices[i].Color);
+                packed[i].Normal = packNormal(_vertices[i].Normal);
+                packUv(_vertices[i].Uv, packed[i].Uv);
+            }
+            _gpuBytes += uploadBuffer(GL_ARRAY_BUFFER, _vertexBufferObject, packed);
+
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, Position));
+            glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, Color));
+            glVertexAttribPointer(2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, Normal));
+            glVertexAttribPointer(3, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, Uv));
+            break;
+        }
+        case VertexFormat::Quantized: {
+            //Flat axes keep a zero scale, every vertex then decodes to the offset
+            _positionOffset = _bounds.Min;
+            _positionScale = _bounds.Max - _bounds.Min;
+            auto inverseScale = glm::vec3(
+                _positionScale.x > 0.f ? 1.f / _positionScale.x : 0.f,
+                _positionScale.y > 0.f ? 1.f / _positionScale.y : 0.f,
+                _positionScale.z > 0.f ? 1.f / _positionScale.z : 0.f);
+
+            std::vector<QuantizedVertex> packed(_vertices.size());
+            for (size_t i = 0; i < _vertices.size(); i++) {
+                auto position = glm::clamp((_vertices[i].Position - _positionOffset) * inverseScale, 0.f, 1.f);
+                for (auto axis = 0; axis < 3; axis++) {
+                    packed[i].Position[axis] = static_cast<uint16_t>(std::round(position[axis] * 65535.f));
+                }
+                packed[i].Color = packColor(_vertices[i].Color);
+                packed[i].Normal = packNormal(_vertices[i].Normal);
+                packUv(_vertices[i].Uv, packed[i].Uv);
+            }
+            _gpuBytes += uploadBuffer(GL_ARRAY_BUFFER, _vertexBufferObject, packed);
+
+            glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, Position));
+            glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, Color));
+            glVertexAttribPointer(2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, Normal));
+            glVertexAttribPointer(3, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, Uv));
+            break;
+        }
+    }
+}
+
+void Mesh::uploadElements() {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _elementBufferObject);
+
+    //Small meshes (all of the procedural shapes) halve their index data
+    if (_vertices.size() <= std::numeric_limits<uint16_t>::max()) {
+        std::vector<uint16_t> shortElements(_elements.begin(), _elements.end());
+        _gpuBytes += uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, _elementBufferObject, shortElements);
+        _indexType = GL_UNSIGNED_SHORT;
+    }
+    else {
+        _gpuBytes += uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, _elementBufferObject, _elements);
+        _indexType = GL_UNSIGNED_INT;
+    }
+}
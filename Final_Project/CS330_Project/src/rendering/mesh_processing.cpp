@@ -0,0 +1,457 @@
+#include <rendering/mesh_processing.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+	//Attributes are compared after rounding, so values that differ by float noise still weld
+	constexpr float WeldPrecision = 1e5f;
+
+	template <size_t N>
+	struct QuantizedKey {
+		std::array<int32_t, N> Values{};
+
+		bool operator==(const QuantizedKey& other) const = default;
+	};
+
+	struct QuantizedKeyHash {
+		template <size_t N>
+		size_t operator()(const QuantizedKey<N>& key) const {
+			//FNV-1a over the rounded values
+			uint64_t hash = 14695981039346656037ull;
+			for (auto value : key.Values) {
+				hash = (hash ^ static_cast<uint32_t>(value)) * 1099511628211ull;
+			}
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	int32_t quantize(float value) {
+		return static_cast<int32_t>(std::lround(value * WeldPrecision));
+	}
+
+	QuantizedKey<3> positionKey(const glm::vec3& position) {
+		return { { quantize(position.x), quantize(position.y), quantize(position.z) } };
+	}
+
+	QuantizedKey<11> vertexKey(const Vertex& vertex) {
+		return { {
+			quantize(vertex.Position.x), quantize(vertex.Position.y), quantize(vertex.Position.z),
+			quantize(vertex.Color.r), quantize(vertex.Color.g), quantize(vertex.Color.b),
+			quantize(vertex.Normal.x), quantize(vertex.Normal.y), quantize(vertex.Normal.z),
+			quantize(vertex.Uv.x), quantize(vertex.Uv.y)
+		} };
+	}
+
+	//Rewrites vertices as the list of unique ones, elements point into it
+	void weldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements) {
+		std::unordered_map<QuantizedKey<11>, uint32_t, QuantizedKeyHash> uniqueVertices;
+		std::vector<uint32_t> remap(vertices.size());
+		std::vector<Vertex> welded;
+		welded.reserve(vertices.size());
+
+		for (uint32_t i = 0; i < vertices.size(); i++) {
+			auto [it, inserted] = uniqueVertices.try_emplace(vertexKey(vertices[i]), static_cast<uint32_t>(welded.size()));
+			if (inserted) {
+				welded.push_back(vertices[i]);
+			}
+			remap[i] = it->second;
+		}
+
+		for (auto& element : elements) {
+			element = remap[element];
+		}
+		vertices = std::move(welded);
+	}
+
+	//Smooth normals from the faces around each position, weighted by face area and corner angle.
+	//Faces across a crease don't contribute, and a vertex whose corners end up with different
+	//normals is split
+	void generateNormals(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements, float creaseAngle) {
+		auto triangleCount = elements.size() / 3;
+		auto cornerCount = triangleCount * 3;
+
+		std::vector<float> faceX(triangleCount), faceY(triangleCount), faceZ(triangleCount);
+		std::vector<float> unitX(triangleCount), unitY(triangleCount), unitZ(triangleCount);
+		std::vector<float> cornerAngles(cornerCount);
+
+		for (size_t t = 0; t < triangleCount; t++) {
+			const auto& p1 = vertices[elements[t * 3]].Position;
+			const auto& p2 = vertices[elements[t * 3 + 1]].Position;
+			const auto& p3 = vertices[elements[t * 3 + 2]].Position;
+
+			//Cross product length is twice the area, which is the area weight
+			auto normal = glm::cross(p2 - p1, p3 - p1);
+			faceX[t] = normal.x;
+			faceY[t] = normal.y;
+			faceZ[t] = normal.z;
+
+			auto length = glm::length(normal);
+			auto inverseLength = length > 0.f ? 1.f / length : 0.f;
+			unitX[t] = normal.x * inverseLength;
+			unitY[t] = normal.y * inverseLength;
+			unitZ[t] = normal.z * inverseLength;
+
+			const glm::vec3* corners[3] = { &p1, &p2, &p3 };
+			for (auto k = 0; k < 3; k++) {
+				auto edge1 = *corners[(k + 1) % 3] - *corners[k];
+				auto edge2 = *corners[(k + 2) % 3] - *corners[k];
+				auto lengths = glm::length(edge1) * glm::length(edge2);
+				cornerAngles[t * 3 + k] = lengths > 0.f ? std::acos(std::clamp(glm::dot(edge1, edge2) / lengths, -1.f, 1.f)) : 0.f;
+			}
+		}
+
+		//Corners grouped by position, UV seams and color changes still smooth across
+		std::unordered_map<QuantizedKey<3>, uint32_t, QuantizedKeyHash> positionGroups;
+		std::vector<uint32_t> groupOfCorner(cornerCount);
+		for (size_t c = 0; c < cornerCount; c++) {
+			auto [it, inserted] = positionGroups.try_emplace(positionKey(vertices[elements[c]].Position), static_cast<uint32_t>(positionGroups.size()));
+			groupOfCorner[c] = it->second;
+		}
+
+		std::vector<uint32_t> groupOffsets(positionGroups.size() + 1, 0);
+		for (auto group : groupOfCorner) {
+			groupOffsets[group + 1]++;
+		}
+		std::partial_sum(groupOffsets.begin(), groupOffsets.end(), groupOffsets.begin());
+
+		std::vector<uint32_t> groupCorners(cornerCount);
+		auto nextCorner = groupOffsets;
+		for (uint32_t c = 0; c < cornerCount; c++) {
+			groupCorners[nextCorner[groupOfCorner[c]]++] = c;
+		}
+
+		auto creaseCosine = std::cos(creaseAngle);
+		std::vector<glm::vec3> cornerNormals(cornerCount);
+
+		for (size_t c = 0; c < cornerCount; c++) {
+			auto t = c / 3;
+			auto group = groupOfCorner[c];
+			glm::vec3 normal{ 0.f };
+
+			for (auto i = groupOffsets[group]; i < groupOffsets[group + 1]; i++) {
+				auto other = groupCorners[i];
+				auto otherTriangle = other / 3;
+				auto cosine = unitX[t] * unitX[otherTriangle] + unitY[t] * unitY[otherTriangle] + unitZ[t] * unitZ[otherTriangle];
+
+				if (cosine >= creaseCosine) {
+					auto weight = cornerAngles[other];
+					normal += glm::vec3(faceX[otherTriangle], faceY[otherTriangle], faceZ[otherTriangle]) * weight;
+				}
+			}
+
+			auto length = glm::length(normal);
+			cornerNormals[c] = length > 0.f ? normal / length : glm::vec3(unitX[t], unitY[t], unitZ[t]);
+		}
+
+		//One output vertex per (input vertex, normal) pair
+		std::unordered_map<QuantizedKey<4>, uint32_t, QuantizedKeyHash> splitVertices;
+		std::vector<Vertex> result;
+		result.reserve(vertices.size());
+
+		for (size_t c = 0; c < cornerCount; c++) {
+			const auto& normal = cornerNormals[c];
+			QuantizedKey<4> key{ { static_cast<int32_t>(elements[c]), quantize(normal.x), quantize(normal.y), quantize(normal.z) } };
+
+			auto [it, inserted] = splitVertices.try_emplace(key, static_cast<uint32_t>(result.size()));
+			if (inserted) {
+				auto& vertex = result.emplace_back(vertices[elements[c]]);
+				vertex.Normal = normal;
+			}
+			elements[c] = it->second;
+		}
+
+		vertices = std::move(result);
+	}
+
+	//Tom Forsyth, "Linear-Speed Vertex Cache Optimisation": greedily emit the triangle whose vertices
+	//score highest, favouring recently used vertices and vertices with few triangles left
+	constexpr uint32_t ForsythCacheSize = 32;
+	constexpr float CacheDecayPower = 1.5f;
+	constexpr float LastTriangleScore = 0.75f;
+	constexpr float ValenceBoostScale = 2.f;
+	constexpr float ValenceBoostPower = 0.5f;
+
+	float forsythScore(int32_t cachePosition, uint32_t liveTriangles) {
+		if (liveTriangles == 0) {
+			return -1.f;
+		}
+
+		auto score = 0.f;
+		if (cachePosition >= 0) {
+			if (cachePosition < 3) {
+				score = LastTriangleScore;
+			}
+			else {
+				auto scaler = 1.f / (ForsythCacheSize - 3);
+				score = std::pow(1.f - (cachePosition - 3) * scaler, CacheDecayPower);
+			}
+		}
+
+		return score + ValenceBoostScale * std::pow(static_cast<float>(liveTriangles), -ValenceBoostPower);
+	}
+
+	std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t>& elements, uint32_t vertexCount) {
+		auto triangleCount = static_cast<uint32_t>(elements.size() / 3);
+
+		//Triangles of every vertex, live ones first in each segment
+		std::vector<uint32_t> liveTriangles(vertexCount, 0);
+		for (auto element : elements) {
+			liveTriangles[element]++;
+		}
+
+		std::vector<uint32_t> offsets(vertexCount + 1, 0);
+		std::partial_sum(liveTriangles.begin(), liveTriangles.end(), offsets.begin() + 1);
+
+		std::vector<uint32_t> adjacency(elements.size());
+		auto fill = offsets;
+		for (uint32_t i = 0; i < elements.size(); i++) {
+			adjacency[fill[elements[i]]++] = i / 3;
+		}
+
+		std::vector<float> vertexScores(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; v++) {
+			vertexScores[v] = forsythScore(-1, liveTriangles[v]);
+		}
+
+		std::vector<uint8_t> emitted(triangleCount, 0);
+		auto triangleScore = [&](uint32_t t) {
+			return vertexScores[elements[t * 3]] + vertexScores[elements[t * 3 + 1]] + vertexScores[elements[t * 3 + 2]];
+		};
+
+		std::vector<uint32_t> result;
+		result.reserve(elements.size());
+
+		std::vector<uint32_t> cache, newCache;
+		cache.reserve(ForsythCacheSize + 3);
+		newCache.reserve(ForsythCacheSize + 3);
+
+		//Start with the best triangle overall, later only triangles touching the cache are scored
+		uint32_t bestTriangle = 0;
+		for (uint32_t t = 1; t < triangleCount; t++) {
+			if (triangleScore(t) > triangleScore(bestTriangle)) {
+				bestTriangle = t;
+			}
+		}
+		uint32_t scanCursor = 0;
+
+		for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+			//Nothing in the cache has triangles left, continue with the next unemitted one
+			if (bestTriangle == triangleCount) {
+				while (emitted[scanCursor]) {
+					scanCursor++;
+				}
+				bestTriangle = scanCursor;
+			}
+
+			emitted[bestTriangle] = 1;
+			const auto* triangle = &elements[bestTriangle * 3];
+
+			newCache.clear();
+			for (auto k = 0; k < 3; k++) {
+				auto vertex = triangle[k];
+				result.push_back(vertex);
+				newCache.push_back(vertex);
+
+				//Move the triangle to the end of the live part of the vertex's segment
+				auto first = offsets[vertex];
+				auto last = first + liveTriangles[vertex];
+				auto position = std::find(adjacency.begin() + first, adjacency.begin() + last, bestTriangle);
+				std::iter_swap(position, adjacency.begin() + last - 1);
+				liveTriangles[vertex]--;
+			}
+
+			for (auto vertex : cache) {
+				if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end()) {
+					newCache.push_back(vertex);
+				}
+			}
+
+			//Vertices falling out of the cache lose their cache score
+			for (auto i = ForsythCacheSize; i < newCache.size(); i++) {
+				vertexScores[newCache[i]] = forsythScore(-1, liveTriangles[newCache[i]]);
+			}
+			newCache.resize(std::min<size_t>(newCache.size(), ForsythCacheSize));
+
+			for (uint32_t i = 0; i < newCache.size(); i++) {
+				vertexScores[newCache[i]] = forsythScore(static_cast<int32_t>(i), liveTriangles[newCache[i]]);
+			}
+
+			//Only triangles touching the cache changed score, the best next one is among them
+			bestTriangle = triangleCount;
+			auto bestScore = -1.f;
+			for (auto vertex : newCache) {
+				for (auto a = offsets[vertex]; a < offsets[vertex] + liveTriangles[vertex]; a++) {
+					auto t = adjacency[a];
+					auto score = triangleScore(t);
+					if (score > bestScore) {
+						bestScore = score;
+						bestTriangle = t;
+					}
+				}
+			}
+
+			std::swap(cache, newCache);
+		}
+
+		return result;
+	}
+
+	//Splits the cache ordered list where a triangle misses on all three vertices (the order restarts
+	//there anyway) and sorts those clusters by how far out they face, so occluders tend to come first.
+	//Cluster contents keep their order, so the cache efficiency is almost unchanged
+	std::vector<uint32_t> optimizeOverdraw(const std::vector<uint32_t>& elements, const std::vector<Vertex>& vertices, uint32_t cacheSize) {
+		auto triangleCount = elements.size() / 3;
+
+		std::vector<uint32_t> clusterStarts;
+		std::vector<uint32_t> cacheTimes(vertices.size(), 0);
+		uint32_t time = cacheSize + 1;
+
+		for (size_t t = 0; t < triangleCount; t++) {
+			auto misses = 0;
+			for (auto k = 0; k < 3; k++) {
+				auto vertex = elements[t * 3 + k];
+				if (time - cacheTimes[vertex] > cacheSize) {
+					cacheTimes[vertex] = time++;
+					misses++;
+				}
+			}
+
+			if (misses == 3 || t == 0) {
+				clusterStarts.push_back(static_cast<uint32_t>(t));
+			}
+		}
+		clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+
+		auto clusterCount = clusterStarts.size() - 1;
+		if (clusterCount < 2) {
+			return elements;
+		}
+
+		//Area weighted centroid of the whole mesh and of every cluster
+		glm::vec3 meshCentroid{ 0.f };
+		auto meshArea = 0.f;
+		std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.f));
+		std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.f));
+		std::vector<float> clusterAreas(clusterCount, 0.f);
+
+		for (size_t cluster = 0; cluster < clusterCount; cluster++) {
+			for (auto t = clusterStarts[cluster]; t < clusterStarts[cluster + 1]; t++) {
+				const auto& p1 = vertices[elements[t * 3]].Position;
+				const auto& p2 = vertices[elements[t * 3 + 1]].Position;
+				const auto& p3 = vertices[elements[t * 3 + 2]].Position;
+
+				auto normal = glm::cross(p2 - p1, p3 - p1);
+				auto area = glm::length(normal);
+				auto centroid = (p1 + p2 + p3) / 3.f;
+
+				clusterCentroids[cluster] += centroid * area;
+				clusterNormals[cluster] += normal;
+				clusterAreas[cluster] += area;
+			}
+
+			meshCentroid += clusterCentroids[cluster];
+			meshArea += clusterAreas[cluster];
+		}
+
+		if (meshArea > 0.f) {
+			meshCentroid /= meshArea;
+		}
+
+		std::vector<float> sortKeys(clusterCount);
+		for (size_t cluster = 0; cluster < clusterCount; cluster++) {
+			auto centroid = clusterAreas[cluster] > 0.f ? clusterCentroids[cluster] / clusterAreas[cluster] : meshCentroid;
+			auto length = glm::length(clusterNormals[cluster]);
+			sortKeys[cluster] = length > 0.f ? glm::dot(centroid - meshCentroid, clusterNormals[cluster] / length) : 0.f;
+		}
+
+		std::vector<uint32_t> order(clusterCount);
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<uint32_t> result;
+		result.reserve(elements.size());
+		for (auto cluster : order) {
+			result.insert(result.end(), elements.begin() + clusterStarts[cluster] * 3, elements.begin() + clusterStarts[cluster + 1] * 3);
+		}
+
+		return result;
+	}
+
+	//Renumbers vertices in the order the index buffer first touches them, unused ones are dropped
+	void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements) {
+		constexpr uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+		std::vector<uint32_t> remap(vertices.size(), unassigned);
+		std::vector<Vertex> result;
+		result.reserve(vertices.size());
+
+		for (auto& element : elements) {
+			if (remap[element] == unassigned) {
+				remap[element] = static_cast<uint32_t>(result.size());
+				result.push_back(vertices[element]);
+			}
+			element = remap[element];
+		}
+
+		vertices = std::move(result);
+	}
+}
+
+float ComputeAcmr(const std::vector<uint32_t>& elements, uint32_t vertexCount, uint32_t cacheSize) {
+	auto triangleCount = elements.size() / 3;
+	if (triangleCount == 0) {
+		return 0.f;
+	}
+
+	//FIFO: a vertex stays cached until cacheSize newer misses pushed it out
+	std::vector<uint32_t> cacheTimes(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+	uint32_t misses = 0;
+
+	for (auto element : elements) {
+		if (time - cacheTimes[element] > cacheSize) {
+			cacheTimes[element] = time++;
+			misses++;
+		}
+	}
+
+	return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
+MeshProcessingStats ProcessMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& elements, const MeshProcessingOptions& options) {
+	MeshProcessingStats stats{
+		.VerticesBefore = static_cast<uint32_t>(vertices.size()),
+		.AcmrBefore = ComputeAcmr(elements, static_cast<uint32_t>(vertices.size()))
+	};
+
+	if (options.Weld) {
+		weldVertices(vertices, elements);
+	}
+
+	auto missingNormals = std::any_of(vertices.begin(), vertices.end(), [](const Vertex& vertex) {
+		return glm::dot(vertex.Normal, vertex.Normal) == 0.f;
+	});
+
+	if (options.RecomputeNormals || missingNormals) {
+		generateNormals(vertices, elements, options.CreaseAngle);
+	}
+
+	if (options.OptimizeVertexCache) {
+		elements = optimizeVertexCache(elements, static_cast<uint32_t>(vertices.size()));
+	}
+
+	if (options.OptimizeOverdraw) {
+		elements = optimizeOverdraw(elements, vertices, 16);
+	}
+
+	if (options.OptimizeVertexFetch) {
+		optimizeVertexFetch(vertices, elements);
+	}
+
+	stats.VerticesAfter = static_cast<uint32_t>(vertices.size());
+	stats.AcmrAfter = ComputeAcmr(elements, static_cast<uint32_t>(vertices.size()));
+	return stats;
+}
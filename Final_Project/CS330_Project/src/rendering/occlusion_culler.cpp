@@ -0,0 +1,348 @@
+#include <rendering/occlusion_culler.h>
+#include <core/job_system.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_CULLER_SSE2 1
+#endif
+
+namespace {
+	//Corners closer than this (in clip w) are behind the camera, skip rather than clip them
+	constexpr float MinClipW = 1e-4f;
+
+	//The 12 triangles of a box, using the corner numbering of BoundingBox::Transformed
+	constexpr uint8_t BoxTriangles[36] = {
+		0, 1, 3,  0, 3, 2, // -z
+		4, 6, 7,  4, 7, 5, // +z
+		0, 4, 5,  0, 5, 1, // -y
+		2, 3, 7,  2, 7, 6, // +y
+		0, 2, 6,  0, 6, 4, // -x
+		1, 5, 7,  1, 7, 3  // +x
+	};
+
+	glm::vec3 boxCorner(const BoundingBox& box, int index) {
+		return {
+			(index & 1) ? box.Max.x : box.Min.x,
+			(index & 2) ? box.Max.y : box.Min.y,
+			(index & 4) ? box.Max.z : box.Min.z
+		};
+	}
+}
+
+OcclusionCuller::OcclusionCuller(int width, int height) :
+	_width{ (std::max(width, 4) + 3) & ~3 }, //SIMD rows are processed 4 pixels at a time
+	_height{ std::max(height, 1) }
+{
+	_tilesX = (_width + TileSize - 1) / TileSize;
+	_tilesY = (_height + TileSize - 1) / TileSize;
+	_tileBins.resize(_tilesX * _tilesY);
+
+	auto levelWidth = _width;
+	auto levelHeight = _height;
+	while (true) {
+		auto& level = _levels.emplace_back();
+		level.Width = levelWidth;
+		level.Height = levelHeight;
+		level.Depth.assign(static_cast<size_t>(levelWidth) * levelHeight, 1.f);
+
+		if (levelWidth == 1 && levelHeight == 1) {
+			break;
+		}
+		levelWidth = std::max(1, (levelWidth + 1) / 2);
+		levelHeight = std::max(1, (levelHeight + 1) / 2);
+	}
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& viewProjection) {
+	_viewProjection = viewProjection;
+	_triangles.clear();
+	_occluderTriangles = 0;
+	_testedObjects = 0;
+	_culledObjects = 0;
+}
+
+void OcclusionCuller::AddOccluder(const glm::mat4& transform, const BoundingBox& localBounds) {
+	if (localBounds.IsEmpty()) {
+		return;
+	}
+
+	auto modelViewProjection = _viewProjection * transform;
+
+	glm::vec3 screen[8];
+	for (auto i = 0; i < 8; i++) {
+		auto clip = modelViewProjection * glm::vec4(boxCorner(localBounds, i), 1.f);
+
+		//Dropping an occluder only makes culling less aggressive, never wrong
+		if (clip.w < MinClipW) {
+			return;
+		}
+
+		auto ndc = glm::vec3(clip) / clip.w;
+		screen[i] = {
+			(ndc.x * 0.5f + 0.5f) * static_cast<float>(_width),
+			(ndc.y * 0.5f + 0.5f) * static_cast<float>(_height),
+			ndc.z * 0.5f + 0.5f
+		};
+	}
+
+	for (auto i = 0; i < 36; i += 3) {
+		ScreenTriangle triangle{
+			.Vertices = { screen[BoxTriangles[i]], screen[BoxTriangles[i + 1]], screen[BoxTriangles[i + 2]] }
+		};
+
+		auto minPoint = glm::min(glm::min(triangle.Vertices[0], triangle.Vertices[1]), triangle.Vertices[2]);
+		auto maxPoint = glm::max(glm::max(triangle.Vertices[0], triangle.Vertices[1]), triangle.Vertices[2]);
+
+		if (maxPoint.x < 0.f || maxPoint.y < 0.f || minPoint.x >= _width || minPoint.y >= _height) {
+			continue;
+		}
+
+		triangle.Min = {
+			std::clamp(static_cast<int>(std::floor(minPoint.x)), 0, _width - 1),
+			std::clamp(static_cast<int>(std::floor(minPoint.y)), 0, _height - 1)
+		};
+		triangle.Max = {
+			std::clamp(static_cast<int>(std::ceil(maxPoint.x)), 0, _width - 1),
+			std::clamp(static_cast<int>(std::ceil(maxPoint.y)), 0, _height - 1)
+		};
+
+		_triangles.emplace_back(triangle);
+	}
+}
+
+void OcclusionCuller::RasterizeOccluders(JobSystem& jobs) {
+	_occluderTriangles = static_cast<uint32_t>(_triangles.size());
+
+	//Bin triangles into the screen tiles they touch
+	for (auto& bin : _tileBins) {
+		bin.clear();
+	}
+
+	for (uint32_t i = 0; i < _triangles.size(); i++) {
+		const auto& triangle = _triangles[i];
+		for (auto tileY = triangle.Min.y / TileSize; tileY <= triangle.Max.y / TileSize; tileY++) {
+			for (auto tileX = triangle.Min.x / TileSize; tileX <= triangle.Max.x / TileSize; tileX++) {
+				_tileBins[tileY * _tilesX + tileX].push_back(i);
+			}
+		}
+	}
+
+	//Each job owns whole tiles, so no two threads ever touch the same pixel
+	jobs.ParallelFor(0, static_cast<uint32_t>(_tileBins.size()), 1, [this](uint32_t first, uint32_t last) {
+		for (auto tile = first; tile < last; tile++) {
+			rasterizeTile(tile);
+		}
+	});
+
+	buildDepthHierarchy();
+}
+
+void OcclusionCuller::rasterizeTile(uint32_t tileIndex) {
+	glm::ivec2 tileMin{
+		static_cast<int>(tileIndex % _tilesX) * TileSize,
+		static_cast<int>(tileIndex / _tilesX) * TileSize
+	};
+	glm::ivec2 tileMax{
+		std::min(tileMin.x + TileSize, _width),
+		std::min(tileMin.y + TileSize, _height)
+	};
+
+	//Clear the tile to the far plane
+	auto& depth = _levels[0].Depth;
+	for (auto y = tileMin.y; y < tileMax.y; y++) {
+		std::fill(depth.begin() + y * _width + tileMin.x, depth.begin() + y * _width + tileMax.x, 1.f);
+	}
+
+	for (auto triangleIndex : _tileBins[tileIndex]) {
+		rasterizeTriangle(_triangles[triangleIndex], tileMin, tileMax);
+	}
+}
+
+void OcclusionCuller::rasterizeTriangle(const ScreenTriangle& triangle, const glm::ivec2& tileMin, const glm::ivec2& tileMax) {
+	auto v0 = triangle.Vertices[0];
+	auto v1 = triangle.Vertices[1];
+	auto v2 = triangle.Vertices[2];
+
+	//Occluders are rasterized two sided, wind every triangle counter clockwise
+	auto area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+	if (std::abs(area) < 1e-6f) {
+		return;
+	}
+	if (area < 0.f) {
+		std::swap(v1, v2);
+		area = -area;
+	}
+
+	//Edge functions in the form A * x + B * y + C, edge i is opposite vertex i
+	const glm::vec3* edgeStart[3] = { &v1, &v2, &v0 };
+	const glm::vec3* edgeEnd[3] = { &v2, &v0, &v1 };
+	float edgeA[3], edgeB[3], edgeC[3];
+	for (auto i = 0; i < 3; i++) {
+		edgeA[i] = edgeStart[i]->y - edgeEnd[i]->y;
+		edgeB[i] = edgeEnd[i]->x - edgeStart[i]->x;
+		edgeC[i] = -(edgeA[i] * edgeStart[i]->x + edgeB[i] * edgeStart[i]->y);
+	}
+
+	//Depth plane from barycentric weights
+	auto inverseArea = 1.f / area;
+	auto depthA = (edgeA[0] * v0.z + edgeA[1] * v1.z + edgeA[2] * v2.z) * inverseArea;
+	auto depthB = (edgeB[0] * v0.z + edgeB[1] * v1.z + edgeB[2] * v2.z) * inverseArea;
+	auto depthC = (edgeC[0] * v0.z + edgeC[1] * v1.z + edgeC[2] * v2.z) * inverseArea;
+
+	//Tile edges are multiples of 4, so aligning the start down keeps every 4-wide block inside the tile
+	auto startX = std::max(triangle.Min.x, tileMin.x) & ~3;
+	auto endX = std::min(triangle.Max.x, tileMax.x - 1);
+	auto startY = std::max(triangle.Min.y, tileMin.y);
+	auto endY = std::min(triangle.Max.y, tileMax.y - 1);
+
+	auto* depth = _levels[0].Depth.data();
+
+#ifdef OCCLUSION_CULLER_SSE2
+	const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	const __m128 zero = _mm_setzero_ps();
+
+	__m128 a0 = _mm_set1_ps(edgeA[0]), a1 = _mm_set1_ps(edgeA[1]), a2 = _mm_set1_ps(edgeA[2]);
+	__m128 aZ = _mm_set1_ps(depthA);
+
+	for (auto y = startY; y <= endY; y++) {
+		auto pixelY = static_cast<float>(y) + 0.5f;
+
+		__m128 rowE0 = _mm_set1_ps(edgeB[0] * pixelY + edgeC[0]);
+		__m128 rowE1 = _mm_set1_ps(edgeB[1] * pixelY + edgeC[1]);
+		__m128 rowE2 = _mm_set1_ps(edgeB[2] * pixelY + edgeC[2]);
+		__m128 rowZ = _mm_set1_ps(depthB * pixelY + depthC);
+
+		auto* row = depth + static_cast<size_t>(y) * _width;
+
+		for (auto x = startX; x <= endX; x += 4) {
+			__m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), pixelOffsets);
+
+			__m128 e0 = _mm_add_ps(_mm_mul_ps(a0, pixelX), rowE0);
+			__m128 e1 = _mm_add_ps(_mm_mul_ps(a1, pixelX), rowE1);
+			__m128 e2 = _mm_add_ps(_mm_mul_ps(a2, pixelX), rowE2);
+
+			__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+			if (_mm_movemask_ps(inside) == 0) {
+				continue;
+			}
+
+			__m128 z = _mm_add_ps(_mm_mul_ps(aZ, pixelX), rowZ);
+			__m128 oldDepth = _mm_loadu_ps(row + x);
+			__m128 newDepth = _mm_min_ps(oldDepth, z);
+
+			_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, newDepth), _mm_andnot_ps(inside, oldDepth)));
+		}
+	}
+#else
+	for (auto y = startY; y <= endY; y++) {
+		auto pixelY = static_cast<float>(y) + 0.5f;
+		auto* row = depth + static_cast<size_t>(y) * _width;
+
+		for (auto x = startX; x <= endX; x++) {
+			auto pixelX = static_cast<float>(x) + 0.5f;
+
+			auto e0 = edgeA[0] * pixelX + edgeB[0] * pixelY + edgeC[0];
+			auto e1 = edgeA[1] * pixelX + edgeB[1] * pixelY + edgeC[1];
+			auto e2 = edgeA[2] * pixelX + edgeB[2] * pixelY + edgeC[2];
+
+			if (e0 >= 0.f && e1 >= 0.f && e2 >= 0.f) {
+				auto z = depthA * pixelX + depthB * pixelY + depthC;
+				row[x] = std::min(row[x], z);
+			}
+		}
+	}
+#endif
+}
+
+void OcclusionCuller::buildDepthHierarchy() {
+	for (size_t i = 1; i < _levels.size(); i++) {
+		const auto& source = _levels[i - 1];
+		auto& target = _levels[i];
+
+		for (auto y = 0; y < target.Height; y++) {
+			auto sourceY0 = std::min(y * 2, source.Height - 1);
+			auto sourceY1 = std::min(y * 2 + 1, source.Height - 1);
+
+			for (auto x = 0; x < target.Width; x++) {
+				auto sourceX0 = std::min(x * 2, source.Width - 1);
+				auto sourceX1 = std::min(x * 2 + 1, source.Width - 1);
+
+				target.Depth[y * target.Width + x] = std::max(
+					std::max(source.Depth[sourceY0 * source.Width + sourceX0], source.Depth[sourceY0 * source.Width + sourceX1]),
+					std::max(source.Depth[sourceY1 * source.Width + sourceX0], source.Depth[sourceY1 * source.Width + sourceX1])
+				);
+			}
+		}
+	}
+}
+
+OcclusionStats OcclusionCuller::GetStats() const {
+	return {
+		.OccluderTriangles = _occluderTriangles,
+		.TestedObjects = _testedObjects.load(std::memory_order_relaxed),
+		.CulledObjects = _culledObjects.load(std::memory_order_relaxed)
+	};
+}
+
+bool OcclusionCuller::IsVisible(const BoundingBox& worldBounds) const {
+	_testedObjects.fetch_add(1, std::memory_order_relaxed);
+
+	if (_triangles.empty() || worldBounds.IsEmpty()) {
+		return true;
+	}
+
+	glm::vec2 minPoint{ std::numeric_limits<float>::max() };
+	glm::vec2 maxPoint{ -std::numeric_limits<float>::max() };
+	auto nearestDepth = 1.f;
+
+	for (auto i = 0; i < 8; i++) {
+		auto clip = _viewProjection * glm::vec4(boxCorner(worldBounds, i), 1.f);
+
+		//Box crosses the camera plane, it can't be behind anything
+		if (clip.w < MinClipW) {
+			return true;
+		}
+
+		auto ndc = glm::vec3(clip) / clip.w;
+		glm::vec2 screen{
+			(ndc.x * 0.5f + 0.5f) * static_cast<float>(_width),
+			(ndc.y * 0.5f + 0.5f) * static_cast<float>(_height)
+		};
+
+		minPoint = glm::min(minPoint, screen);
+		maxPoint = glm::max(maxPoint, screen);
+		nearestDepth = std::min(nearestDepth, ndc.z * 0.5f + 0.5f);
+	}
+
+	//Off screen objects are left to frustum culling
+	if (maxPoint.x < 0.f || maxPoint.y < 0.f || minPoint.x >= _width || minPoint.y >= _height || nearestDepth < 0.f) {
+		return true;
+	}
+
+	auto x0 = std::clamp(static_cast<int>(minPoint.x), 0, _width - 1);
+	auto y0 = std::clamp(static_cast<int>(minPoint.y), 0, _height - 1);
+	auto x1 = std::clamp(static_cast<int>(maxPoint.x), 0, _width - 1);
+	auto y1 = std::clamp(static_cast<int>(maxPoint.y), 0, _height - 1);
+
+	//Pick the level where the box covers at most a few texels
+	size_t levelIndex = 0;
+	auto extent = std::max(x1 - x0, y1 - y0) + 1;
+	while (extent > 4 && levelIndex + 1 < _levels.size()) {
+		extent = (extent + 1) / 2;
+		levelIndex++;
+	}
+
+	const auto& level = _levels[levelIndex];
+	for (auto y = y0 >> levelIndex; y <= (y1 >> levelIndex); y++) {
+		for (auto x = x0 >> levelIndex; x <= (x1 >> levelIndex); x++) {
+			if (nearestDepth <= level.Depth[y * level.Width + x]) {
+				return true;
+			}
+		}
+	}
+
+	_culledObjects.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
@@ -0,0 +1,72 @@
+#include <rendering/packet_builder.h>
+#include <rendering/mesh.h>
+#include <rendering/shader.h>
+#include <core/job_system.h>
+#include <algorithm>
+
+namespace {
+	//16 bits of program, 24 of material (its textures) and 24 of vertex array, most expensive change first
+	uint64_t makeSortKey(const DrawPacket& packet, const Material& material) {
+		return (static_cast<uint64_t>(material.Program->GetHandle() & 0xffff) << 48) |
+			(static_cast<uint64_t>(packet.Material & 0xffffff) << 24) |
+			(packet.Geometry->GetVertexArray() & 0xffffff);
+	}
+}
+
+void PacketBuilder::Begin(const JobSystem& jobs) {
+	_buffers.resize(jobs.GetThreadCount());
+
+	//clear keeps the capacity, steady frames don't allocate
+	for (auto& buffer : _buffers) {
+		buffer.clear();
+	}
+}
+
+void PacketBuilder::Merge(JobSystem& jobs, const MaterialLibrary& materials, std::vector<DrawPacket>& packets) {
+	std::vector<uint32_t> offsets(_buffers.size() + 1, 0);
+	for (size_t i = 0; i < _buffers.size(); i++) {
+		offsets[i + 1] = offsets[i] + static_cast<uint32_t>(_buffers[i].size());
+	}
+
+	_order.resize(offsets.back());
+
+	jobs.ParallelFor(0, static_cast<uint32_t>(_buffers.size()), 1, [&](uint32_t first, uint32_t last) {
+		for (auto buffer = first; buffer < last; buffer++) {
+			for (uint32_t i = 0; i < _buffers[buffer].size(); i++) {
+				auto& packet = _buffers[buffer][i];
+				packet.SortKey = makeSortKey(packet, materials.Get(packet.Material));
+				_order[offsets[buffer] + i] = { packet.SortKey, offsets[buffer] + i };
+			}
+		}
+	});
+
+	//Position breaks ties, so equal keys keep the gather order of their buffer
+	std::sort(_order.begin(), _order.end());
+
+	packets.clear();
+	packets.reserve(_order.size());
+	for (const auto& [key, position] : _order) {
+		auto buffer = std::upper_bound(offsets.begin(), offsets.end(), position) - offsets.begin() - 1;
+		packets.push_back(_buffers[buffer][position - offsets[buffer]]);
+	}
+}
+
+void PacketBuilder::SortFrontToBack(const std::vector<DrawPacket>& packets, const glm::vec3& eye, std::vector<uint32_t>& order) {
+	_distances.resize(packets.size());
+	for (uint32_t i = 0; i < packets.size(); i++) {
+		//Center of the world bounds, batches have their vertices in world space and an identity Model
+		const auto& bounds = packets[i].Geometry->GetBounds();
+		auto center = bounds.IsEmpty() ? glm::vec3(packets[i].Model[3])
+			: glm::vec3(packets[i].Model * glm::vec4((bounds.Min + bounds.Max) * 0.5f, 1.f));
+		auto offset = center - eye;
+		_distances[i] = { glm::dot(offset, offset), i };
+	}
+
+	std::sort(_distances.begin(), _distances.end());
+
+	order.clear();
+	order.reserve(_distances.size());
+	for (const auto& [distance, index] : _distances) {
+		order.push_back(index);
+	}
+}
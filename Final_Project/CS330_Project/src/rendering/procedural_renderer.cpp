@@ -0,0 +1,154 @@
+#include <rendering/procedural_renderer.h>
+#include <rendering/gpu_memory.h>
+#include <rendering/texture.h>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace {
+	//After the material buffer
+	constexpr GLuint INSTANCE_STORAGE_BINDING = 4;
+
+	//Fewer sides don't make a closed tube
+	constexpr uint32_t MIN_SECTORS = 3;
+
+	uint32_t sectorsOf(const ProceduralInstance& instance) {
+		return instance.Shape == ProceduralShape::Cylinder ? std::max(instance.Sectors, MIN_SECTORS) : 0;
+	}
+}
+
+ProceduralRenderer::~ProceduralRenderer() {
+	Release();
+}
+
+uint32_t ProceduralRenderer::GetVertexCount(ProceduralShape shape, uint32_t sectors) {
+	switch (shape) {
+		case ProceduralShape::Plane: return 6;
+		case ProceduralShape::Cube: return 36;
+		//Two side and two cap triangles per sector
+		case ProceduralShape::Cylinder: return 12 * std::max(sectors, MIN_SECTORS);
+	}
+	return 0;
+}
+
+bool ProceduralRenderer::Init() {
+	glGenVertexArrays(1, &_vertexArray);
+	glGenBuffers(1, &_instanceBuffer);
+
+	return _vertexArray != 0 && _instanceBuffer != 0;
+}
+
+void ProceduralRenderer::Release() {
+	_programs.clear();
+
+	if (_vertexArray) {
+		glDeleteVertexArrays(1, &_vertexArray);
+		_vertexArray = 0;
+	}
+
+	if (_instanceBuffer) {
+		GpuMemory::Forget(GpuMemory::Kind::Buffer, _instanceBuffer);
+		glDeleteBuffers(1, &_instanceBuffer);
+		_instanceBuffer = 0;
+	}
+
+	_instances.clear();
+	_groups.clear();
+	_triangleCount = 0;
+}
+
+void ProceduralRenderer::Apply(const ProceduralUpdate& update, const std::vector<Material>& materials) {
+	if (update.Changed) {
+		_instances = update.Instances;
+	}
+
+	//Shape and tessellation fix the vertex count, program and textures come from the material
+	using GroupKey = std::tuple<ProceduralShape, uint32_t, Shader*, Texture*, Texture*>;
+	std::vector<GroupKey> keys;
+	keys.reserve(_instances.size());
+
+	for (const auto& instance : _instances) {
+		const auto& material = materials[instance.Material];
+		keys.emplace_back(instance.Shape, sectorsOf(instance), programFor(material.Program), material.Textures[0], material.Textures[1]);
+	}
+
+	std::vector<uint32_t> order(_instances.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+	_groups.clear();
+	_triangleCount = 0;
+	std::vector<InstanceData> data;
+	data.reserve(order.size());
+
+	for (auto index : order) {
+		const auto& instance = _instances[index];
+		const auto& [shape, sectors, program, texture0, texture1] = keys[index];
+
+		if (_groups.empty() || keys[order[data.size() - 1]] != keys[index]) {
+			_groups.push_back({
+				.Shape = shape,
+				.Sectors = sectors,
+				.Program = program,
+				.Textures = { texture0, texture1 },
+				.FirstInstance = static_cast<uint32_t>(data.size())
+			});
+		}
+
+		_groups.back().InstanceCount++;
+		_triangleCount += GetVertexCount(shape, sectors) / 3;
+		data.push_back({
+			.Model = instance.Model,
+			.Size = glm::vec4(instance.Size, 0.f, 0.f),
+			.Material = instance.Material
+		});
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, _instanceBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, data.size() * sizeof(InstanceData), data.data(), GL_STATIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _instanceBuffer, data.size() * sizeof(InstanceData));
+}
+
+Shader* ProceduralRenderer::programFor(const Shader* source) {
+	auto fragmentPath = source && !source->GetFragmentPath().empty() ? source->GetFragmentPath() : Shader::ShaderPath / "basic_lit.frag";
+
+	auto& program = _programs[fragmentPath.string()];
+	if (!program) {
+		program = std::make_unique<Shader>(Shader::ShaderPath / "procedural.vert", fragmentPath);
+	}
+
+	return program.get();
+}
+
+void ProceduralRenderer::Draw(RenderStats& stats) {
+	if (_groups.empty()) {
+		return;
+	}
+
+	glBindVertexArray(_vertexArray);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INSTANCE_STORAGE_BINDING, _instanceBuffer);
+
+	for (const auto& group : _groups) {
+		group.Program->Bind();
+		group.Program->SetUint("shape", static_cast<uint32_t>(group.Shape));
+		group.Program->SetUint("sectors", group.Sectors);
+		//No gl_BaseInstance before GL 4.6, the offset goes in as a uniform
+		group.Program->SetUint("firstInstance", group.FirstInstance);
+
+		for (uint32_t i = 0; i < group.Textures.size(); i++) {
+			if (group.Textures[i]) {
+				glActiveTexture(GL_TEXTURE0 + i);
+				group.Textures[i]->Bind();
+				stats.TextureBinds++;
+			}
+		}
+
+		glDrawArraysInstanced(GL_TRIANGLES, 0, GetVertexCount(group.Shape, group.Sectors), group.InstanceCount);
+	}
+
+	stats.ProgramBinds += static_cast<uint32_t>(_groups.size());
+	stats.DrawCalls += static_cast<uint32_t>(_groups.size());
+	stats.Triangles += _triangleCount;
+
+	glBindVertexArray(0);
+}
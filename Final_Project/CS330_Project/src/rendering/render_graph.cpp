@@ -0,0 +1,478 @@
+#include <rendering/render_graph.h>
+#include <rendering/gpu_memory.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+	int64_t bytesPerPixel(GLenum format) {
+		switch (format) {
+		case GL_R8:
+			return 1;
+		case GL_DEPTH_COMPONENT16:
+			return 2;
+		case GL_RGBA16F:
+		case GL_DEPTH32F_STENCIL8:
+			return 8;
+		case GL_RGBA32F:
+			return 16;
+		default:
+			return 4;
+		}
+	}
+
+	bool isDepthFormat(GLenum format) {
+		return format == GL_DEPTH_COMPONENT16 || format == GL_DEPTH_COMPONENT24 || format == GL_DEPTH_COMPONENT32F
+			|| format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+	}
+
+	bool hasStencil(GLenum format) {
+		return format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+	}
+}
+
+RenderResource RenderPassBuilder::CreateTexture(const char* name, const RenderTextureDesc& desc) {
+	auto& resources = _graph._resources;
+	resources.push_back({ .Name = name, .Kind = RenderGraph::ResourceKind::Texture, .Desc = desc });
+	return static_cast<RenderResource>(resources.size() - 1);
+}
+
+void RenderPassBuilder::Read(RenderResource resource, GLbitfield barrier) {
+	_graph._passes[_pass].Reads.push_back({ resource, barrier });
+}
+
+void RenderPassBuilder::Write(RenderResource resource) {
+	_graph.addWrite(_pass, resource);
+}
+
+void RenderPassBuilder::WriteColor(RenderResource texture, std::optional<glm::vec4> clear) {
+	auto& pass = _graph._passes[_pass];
+	auto slot = std::find(pass.Colors.begin(), pass.Colors.end(), NoResource);
+	if (slot == pass.Colors.end()) {
+		std::cerr << "RenderGraph: pass " << pass.Name << " writes more than " << MaxColorAttachments << " colors" << std::endl;
+		return;
+	}
+
+	*slot = texture;
+	pass.ColorClears[slot - pass.Colors.begin()] = clear;
+	_graph.addWrite(_pass, texture);
+}
+
+void RenderPassBuilder::WriteDepth(RenderResource texture, bool clear) {
+	auto& pass = _graph._passes[_pass];
+	pass.Depth = texture;
+	pass.ClearDepth = clear;
+	_graph.addWrite(_pass, texture);
+}
+
+void RenderPassBuilder::SetRenderArea(int width, int height) {
+	auto& pass = _graph._passes[_pass];
+	pass.Width = width;
+	pass.Height = height;
+}
+
+void RenderPassBuilder::SetSideEffect() {
+	_graph._passes[_pass].SideEffect = true;
+}
+
+RenderGraph::~RenderGraph() {
+	Release();
+}
+
+void RenderGraph::Release() {
+	for (const auto& [key, framebuffer] : _framebuffers) {
+		glDeleteFramebuffers(1, &framebuffer);
+	}
+	_framebuffers.clear();
+
+	for (const auto& texture : _pool) {
+		GpuMemory::Forget(GpuMemory::Kind::Texture, texture.Handle);
+		glDeleteTextures(1, &texture.Handle);
+	}
+	_pool.clear();
+
+	Reset();
+}
+
+void RenderGraph::Reset() {
+	_passes.clear();
+	_resources.clear();
+	_order.clear();
+	_culledPasses = 0;
+}
+
+RenderResource RenderGraph::ImportFramebuffer(const char* name, GLuint framebuffer, int width, int height) {
+	_resources.push_back({
+		.Name = name,
+		.Kind = ResourceKind::Framebuffer,
+		.Imported = true,
+		.Desc = { .Width = width, .Height = height },
+		.Framebuffer = framebuffer
+	});
+	return static_cast<RenderResource>(_resources.size() - 1);
+}
+
+RenderResource RenderGraph::ImportBuffer(const char* name) {
+	_resources.push_back({ .Name = name, .Kind = ResourceKind::Buffer, .Imported = true });
+	return static_cast<RenderResource>(_resources.size() - 1);
+}
+
+void RenderGraph::AddPass(const char* name, const std::function<void(RenderPassBuilder&)>& setup, PassFunction execute) {
+	_passes.push_back({ .Name = name, .Run = std::move(execute) });
+
+	RenderPassBuilder builder{ *this, static_cast<uint32_t>(_passes.size() - 1) };
+	setup(builder);
+
+	//Without an explicit area the pass covers its first attachment
+	auto& pass = _passes.back();
+	auto first = pass.Colors[0] != NoResource ? pass.Colors[0] : pass.Depth;
+	if (pass.Width == 0 && first != NoResource) {
+		pass.Width = _resources[first].Desc.Width;
+		pass.Height = _resources[first].Desc.Height;
+	}
+}
+
+void RenderGraph::Execute(GpuProfiler& profiler) {
+	PROFILE_SCOPE("Render graph");
+
+	link();
+	cull();
+	sort();
+	allocate();
+
+	_boundFramebuffer.reset();
+	_viewport = { -1, -1, -1, -1 };
+
+	for (auto index : _order) {
+		const auto& pass = _passes[index];
+
+		//GPU zones cost nothing outside of a profiler capture
+		PROFILE_SCOPE(pass.Name);
+		GpuProfileScope gpuZone{ profiler, pass.Name };
+
+		//Shader storage and image writes of earlier passes aren't visible to the reads otherwise
+		GLbitfield barrier = 0;
+		for (const auto& read : pass.Reads) {
+			barrier |= read.Barrier;
+		}
+		if (barrier) {
+			glMemoryBarrier(barrier);
+		}
+
+		bind(pass);
+		pass.Run(*this);
+	}
+
+	releaseUnused();
+}
+
+GLuint RenderGraph::GetTexture(RenderResource texture) const {
+	const auto& resource = _resources[texture];
+	return resource.PoolSlot < _pool.size() ? _pool[resource.PoolSlot].Handle : 0;
+}
+
+void RenderGraph::addWrite(uint32_t pass, RenderResource resource) {
+	auto& writes = _passes[pass].Writes;
+	if (std::find(writes.begin(), writes.end(), resource) == writes.end()) {
+		writes.push_back(resource);
+	}
+}
+
+void RenderGraph::link() {
+	auto addEdge = [](std::vector<uint32_t>& edges, uint32_t pass) {
+		if (std::find(edges.begin(), edges.end(), pass) == edges.end()) {
+			edges.push_back(pass);
+		}
+	};
+
+	//Writers of every resource in the order they were added
+	std::vector<std::vector<uint32_t>> writers(_resources.size());
+	for (uint32_t i = 0; i < _passes.size(); i++) {
+		for (auto write : _passes[i].Writes) {
+			writers[write].push_back(i);
+		}
+	}
+
+	for (uint32_t i = 0; i < _passes.size(); i++) {
+		auto& pass = _passes[i];
+
+		//A read sees what the writers added before it wrote, or the final contents when they were
+		//all added later. Reading an older version, the next writer has to wait for this pass
+		for (const auto& read : pass.Reads) {
+			const auto& resourceWriters = writers[read.Resource];
+			auto next = std::lower_bound(resourceWriters.begin(), resourceWriters.end(), i);
+			auto writesItself = next != resourceWriters.end() && *next == i;
+
+			if (next != resourceWriters.begin()) {
+				addEdge(pass.Dependencies, *(next - 1));
+			}
+			else if (!resourceWriters.empty() && !writesItself) {
+				addEdge(pass.Dependencies, resourceWriters.back());
+				continue;
+			}
+
+			auto later = std::upper_bound(resourceWriters.begin(), resourceWriters.end(), i);
+			if (later != resourceWriters.end()) {
+				addEdge(_passes[*later].RunsAfter, i);
+			}
+		}
+
+		//Writers of the same resource keep the order they were added in, each one draws over the one before
+		for (auto write : pass.Writes) {
+			const auto& resourceWriters = writers[write];
+			auto self = std::lower_bound(resourceWriters.begin(), resourceWriters.end(), i);
+			if (self != resourceWriters.begin()) {
+				addEdge(pass.Dependencies, *(self - 1));
+			}
+		}
+	}
+}
+
+void RenderGraph::cull() {
+	auto writesImported = [this](const Pass& pass) {
+		return std::any_of(pass.Writes.begin(), pass.Writes.end(), [this](RenderResource resource) { return _resources[resource].Imported; });
+	};
+
+	std::vector<uint32_t> alive;
+	for (uint32_t i = 0; i < _passes.size(); i++) {
+		if (_passes[i].SideEffect || writesImported(_passes[i])) {
+			_passes[i].Alive = true;
+			alive.push_back(i);
+		}
+	}
+
+	//Everything the kept passes depend on is kept too. Passes only ordered after one aren't
+	for (size_t i = 0; i < alive.size(); i++) {
+		for (auto dependency : _passes[alive[i]].Dependencies) {
+			if (!_passes[dependency].Alive) {
+				_passes[dependency].Alive = true;
+				alive.push_back(dependency);
+			}
+		}
+	}
+
+	_culledPasses = static_cast<uint32_t>(_passes.size() - alive.size());
+}
+
+void RenderGraph::sort() {
+	//Kahn's algorithm over the kept passes, the earliest added ready pass goes first, so passes
+	//already added in a valid order run in that order
+	std::vector<uint32_t> waitingFor(_passes.size(), 0);
+	std::vector<std::vector<uint32_t>> successors(_passes.size());
+	for (uint32_t i = 0; i < _passes.size(); i++) {
+		const auto& pass = _passes[i];
+		if (!pass.Alive) {
+			continue;
+		}
+
+		for (const auto* edges : { &pass.Dependencies, &pass.RunsAfter }) {
+			for (auto predecessor : *edges) {
+				if (_passes[predecessor].Alive) {
+					successors[predecessor].push_back(i);
+					waitingFor[i]++;
+				}
+			}
+		}
+	}
+
+	_order.clear();
+	std::vector<bool> scheduled(_passes.size(), false);
+	while (true) {
+		uint32_t next = 0;
+		while (next < _passes.size() && (!_passes[next].Alive || scheduled[next] || waitingFor[next] > 0)) {
+			next++;
+		}
+		if (next == _passes.size()) {
+			break;
+		}
+
+		scheduled[next] = true;
+		_order.push_back(next);
+		for (auto successor : successors[next]) {
+			waitingFor[successor]--;
+		}
+	}
+
+	//Only a cycle leaves passes behind, they run in the order they were added
+	for (uint32_t i = 0; i < _passes.size(); i++) {
+		if (_passes[i].Alive && !scheduled[i]) {
+			std::cerr << "RenderGraph: pass " << _passes[i].Name << " is part of a dependency cycle" << std::endl;
+			_order.push_back(i);
+		}
+	}
+}
+
+void RenderGraph::allocate() {
+	//Lifetimes in positions of the run order
+	auto touch = [this](RenderResource resource, uint32_t position) {
+		auto& entry = _resources[resource];
+		entry.FirstUse = std::min(entry.FirstUse, position);
+		entry.LastUse = std::max(entry.LastUse, position);
+	};
+
+	for (uint32_t position = 0; position < _order.size(); position++) {
+		const auto& pass = _passes[_order[position]];
+		for (const auto& read : pass.Reads) {
+			touch(read.Resource, position);
+		}
+		for (auto write : pass.Writes) {
+			touch(write, position);
+		}
+	}
+
+	for (auto& texture : _pool) {
+		texture.UsedThisFrame = false;
+	}
+
+	//In order of first use, so a texture freed by an earlier transient is taken by the next one
+	std::vector<RenderResource> transients;
+	for (RenderResource i = 0; i < _resources.size(); i++) {
+		if (_resources[i].Kind == ResourceKind::Texture && !_resources[i].Imported && _resources[i].FirstUse != ~0u) {
+			transients.push_back(i);
+		}
+	}
+	std::stable_sort(transients.begin(), transients.end(), [this](RenderResource a, RenderResource b) {
+		return _resources[a].FirstUse < _resources[b].FirstUse;
+	});
+
+	for (auto transient : transients) {
+		auto& resource = _resources[transient];
+		resource.PoolSlot = acquire(resource.Desc, resource.FirstUse, resource.LastUse);
+	}
+}
+
+uint32_t RenderGraph::acquire(const RenderTextureDesc& desc, uint32_t firstUse, uint32_t lastUse) {
+	for (uint32_t i = 0; i < _pool.size(); i++) {
+		auto& texture = _pool[i];
+		if (texture.Desc == desc && (!texture.UsedThisFrame || texture.BusyUntil < firstUse)) {
+			texture.UsedThisFrame = true;
+			texture.BusyUntil = lastUse;
+			texture.UnusedFrames = 0;
+			return i;
+		}
+	}
+
+	GLuint handle = 0;
+	glGenTextures(1, &handle);
+	glBindTexture(GL_TEXTURE_2D, handle);
+	glTexStorage2D(GL_TEXTURE_2D, 1, desc.Format, desc.Width, desc.Height);
+
+	//Color is filtered by the passes sampling it, depth is read texel by texel
+	auto filter = isDepthFormat(desc.Format) ? GL_NEAREST : GL_LINEAR;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	GpuMemory::Track(GpuMemory::Kind::Texture, handle, static_cast<int64_t>(desc.Width) * desc.Height * bytesPerPixel(desc.Format));
+
+	_pool.push_back({ .Handle = handle, .Desc = desc, .BusyUntil = lastUse, .UsedThisFrame = true });
+	return static_cast<uint32_t>(_pool.size() - 1);
+}
+
+void RenderGraph::releaseUnused() {
+	for (auto i = _pool.size(); i-- > 0;) {
+		auto& texture = _pool[i];
+		if (texture.UsedThisFrame || ++texture.UnusedFrames <= MaxUnusedFrames) {
+			continue;
+		}
+
+		//Framebuffers with the texture attached go with it
+		for (auto it = _framebuffers.begin(); it != _framebuffers.end();) {
+			if (std::find(it->first.begin(), it->first.end(), texture.Handle) != it->first.end()) {
+				glDeleteFramebuffers(1, &it->second);
+				it = _framebuffers.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+
+		GpuMemory::Forget(GpuMemory::Kind::Texture, texture.Handle);
+		glDeleteTextures(1, &texture.Handle);
+		_pool.erase(_pool.begin() + i);
+	}
+}
+
+void RenderGraph::bind(const Pass& pass) {
+	//Compute and copy passes leave the framebuffer alone
+	if (pass.Colors[0] == NoResource && pass.Depth == NoResource) {
+		return;
+	}
+
+	auto framebuffer = framebufferFor(pass);
+	if (_boundFramebuffer != framebuffer) {
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		_boundFramebuffer = framebuffer;
+	}
+
+	std::array<GLint, 4> viewport{ 0, 0, pass.Width, pass.Height };
+	if (viewport != _viewport) {
+		glViewport(0, 0, pass.Width, pass.Height);
+		_viewport = viewport;
+	}
+
+	//Clears go through the write masks, passes turning them off restore them before they return
+	for (uint32_t i = 0; i < pass.Colors.size(); i++) {
+		if (pass.ColorClears[i]) {
+			glClearBufferfv(GL_COLOR, i, &pass.ColorClears[i]->x);
+		}
+	}
+	if (pass.ClearDepth) {
+		glClearBufferfi(GL_DEPTH_STENCIL, 0, 1.f, 0);
+	}
+}
+
+GLuint RenderGraph::framebufferFor(const Pass& pass) {
+	auto first = pass.Colors[0] != NoResource ? pass.Colors[0] : pass.Depth;
+	if (_resources[first].Kind == ResourceKind::Framebuffer) {
+		return _resources[first].Framebuffer;
+	}
+
+	FramebufferKey key{};
+	for (uint32_t i = 0; i < pass.Colors.size(); i++) {
+		key[i] = pass.Colors[i] != NoResource ? GetTexture(pass.Colors[i]) : 0;
+	}
+	key.back() = pass.Depth != NoResource ? GetTexture(pass.Depth) : 0;
+
+	auto cached = _framebuffers.find(key);
+	if (cached != _framebuffers.end()) {
+		return cached->second;
+	}
+
+	GLuint framebuffer = 0;
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+	std::array<GLenum, RenderPassBuilder::MaxColorAttachments> drawBuffers{};
+	GLsizei drawBufferCount = 0;
+	for (uint32_t i = 0; i < pass.Colors.size(); i++) {
+		if (pass.Colors[i] == NoResource) {
+			break;
+		}
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, key[i], 0);
+		drawBuffers[drawBufferCount++] = GL_COLOR_ATTACHMENT0 + i;
+	}
+
+	if (pass.Depth != NoResource) {
+		auto attachment = hasStencil(_resources[pass.Depth].Desc.Format) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+		glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, key.back(), 0);
+	}
+
+	//Depth only passes write no color at all
+	if (drawBufferCount > 0) {
+		glDrawBuffers(drawBufferCount, drawBuffers.data());
+	}
+	else {
+		glDrawBuffer(GL_NONE);
+	}
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		std::cerr << "RenderGraph: framebuffer of pass " << pass.Name << " incomplete" << std::endl;
+	}
+
+	//Bound here already, bind() sees it as current
+	_boundFramebuffer = framebuffer;
+	_framebuffers.emplace(key, framebuffer);
+	return framebuffer;
+}
@@ -0,0 +1,522 @@
+#include <rendering/render_thread.h>
+#include <rendering/mesh.h>
+#include <rendering/shader.h>
+#include <rendering/texture.h>
+#include <rendering/uniform_blocks.h>
+#include <rendering/gpu_memory.h>
+#include <rendering/gl_trace.h>
+#include <core/profiler.h>
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+	//Light block from up to MAX_POINT_LIGHTS lights, unused slots stay black
+	template <typename GetLight>
+	void writeLightBlock(const StreamAllocation& allocation, const DirectionalLight& dirLight, GetLight getLight) {
+		LightBlock block{};
+		block.DirLight = ToBlock(dirLight);
+		for (uint32_t i = 0; i < MAX_POINT_LIGHTS; i++) {
+			block.PointLights[i] = ToBlock(getLight(i));
+		}
+
+		std::memcpy(allocation.Data, &block, sizeof(block));
+	}
+}
+
+RenderThread::~RenderThread() {
+	Stop();
+}
+
+void RenderThread::Start(GLFWwindow* window, bool offscreen) {
+	_window = window;
+	_offscreen = offscreen;
+	_stopping = false;
+	_thread = std::thread(&RenderThread::renderLoop, this);
+}
+
+void RenderThread::Stop() {
+	if (!_thread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard lock(_mutex);
+		_stopping = true;
+	}
+	_frameSubmitted.notify_one();
+
+	_thread.join();
+}
+
+FrameSnapshot& RenderThread::BeginFrame() {
+	PROFILE_SCOPE("Wait for frame slot");
+	std::unique_lock lock(_mutex);
+
+	//The slot of frame N is reused by frame N + FrameCount, wait until that one was drawn
+	_frameRendered.wait(lock, [this]() { return _submittedFrames - _renderedFrames < FrameCount; });
+
+	return _frames[_submittedFrames % FrameCount];
+}
+
+void RenderThread::SubmitFrame() {
+	{
+		std::lock_guard lock(_mutex);
+		_submittedFrames++;
+	}
+	_frameSubmitted.notify_one();
+}
+
+StreamBufferStats RenderThread::GetStreamStats() {
+	std::lock_guard lock(_mutex);
+	return _streamStats;
+}
+
+RenderStats RenderThread::GetRenderStats() {
+	std::lock_guard lock(_mutex);
+	return _renderStats;
+}
+
+void RenderThread::renderLoop() {
+	PROFILE_THREAD("Render");
+	glfwMakeContextCurrent(_window);
+
+	//Uniform block ranges have to start on this alignment
+	GLint uniformAlignment = 256;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+	_uniformAlignment = uniformAlignment;
+
+	//Grows on demand, 1MB holds a few thousand draws
+	_streamBuffer.Init(1 << 20);
+
+	if (!_indirectRenderer.Init()) {
+		std::cerr << "RenderThread: GPU driven path unavailable" << std::endl;
+	}
+
+	if (!_proceduralRenderer.Init()) {
+		std::cerr << "RenderThread: procedural path unavailable" << std::endl;
+	}
+
+	if (!_gpuProfiler.Init()) {
+		std::cerr << "RenderThread: GPU timer queries unavailable" << std::endl;
+	}
+
+	if (!_hudRenderer.Init()) {
+		std::cerr << "RenderThread: performance overlay unavailable" << std::endl;
+	}
+
+	if (!_dynamicResolution.Init()) {
+		std::cerr << "RenderThread: dynamic resolution unavailable" << std::endl;
+	}
+
+	_depthShader = std::make_unique<Shader>(Shader::ShaderPath / "depth_prepass.vert", Shader::ShaderPath / "depth_prepass.frag");
+	if (!_depthShader->GetHandle()) {
+		std::cerr << "RenderThread: depth pre-pass unavailable" << std::endl;
+	}
+
+	_frameCapture.Init();
+
+	//Stays bound, every program reads its material parameters from here
+	glGenBuffers(1, &_materialBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MATERIAL_STORAGE_BINDING, _materialBuffer);
+
+	while (true) {
+		{
+			PROFILE_SCOPE("Wait for snapshot");
+			std::unique_lock lock(_mutex);
+			_frameSubmitted.wait(lock, [this]() { return _stopping || _renderedFrames < _submittedFrames; });
+
+			if (_renderedFrames == _submittedFrames) {
+				break;
+			}
+		}
+
+		_gpuProfiler.BeginFrame();
+		auto submitStart = std::chrono::steady_clock::now();
+		bool drawn;
+		{
+			PROFILE_SCOPE("Submit");
+			PROFILE_GPU_SCOPE(_gpuProfiler, "Frame");
+
+			//Only this thread advances _renderedFrames, the slot stays reserved until it does
+			drawn = submit(_frames[_renderedFrames % FrameCount]);
+		}
+		_frameStats.SubmitMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submitStart).count();
+
+		if (drawn) {
+			const auto& frame = _frames[_renderedFrames % FrameCount];
+			_frameCapture.EndFrame(frame.CapturePath, frame.Width, frame.Height);
+		}
+		_gpuProfiler.EndFrame();
+		GlTrace::EndFrame();
+
+		//A skipped frame leaves the back buffer undefined, the last presented image stays up
+		if (drawn) {
+			PROFILE_SCOPE("Swap buffers");
+			if (_offscreen) {
+				//Nothing to present, still hand the frame to the driver like a swap would
+				glFlush();
+			}
+			else {
+				//Only this thread may call it, the context is current here
+				const auto& frame = _frames[_renderedFrames % FrameCount];
+				if (frame.SwapInterval != _swapInterval) {
+					_swapInterval = frame.SwapInterval;
+					glfwSwapInterval(_swapInterval);
+				}
+
+				glfwSwapBuffers(_window);
+			}
+		}
+
+		{
+			std::lock_guard lock(_mutex);
+			_renderedFrames++;
+			_streamStats = _streamBuffer.GetStats();
+			_renderStats = _frameStats;
+		}
+		_frameRendered.notify_one();
+	}
+
+	//GL objects of this thread go first, then hand the context back so the main thread can clean up
+	_indirectRenderer.Release();
+	_proceduralRenderer.Release();
+	_gpuProfiler.Release();
+	_hudRenderer.Release();
+	_dynamicResolution.Release();
+	_renderGraph.Release();
+	_depthShader.reset();
+	_frameCapture.Release();
+	_streamBuffer.Release();
+	releaseOffscreenTarget();
+	GpuMemory::Forget(GpuMemory::Kind::Buffer, _materialBuffer);
+	glDeleteBuffers(1, &_materialBuffer);
+	_materialBuffer = 0;
+	glfwMakeContextCurrent(nullptr);
+}
+
+bool RenderThread::submit(const FrameSnapshot& frame) {
+	GL_TRACE_SCOPE("Frame setup");
+	_frameStats = {};
+
+	//The viewport is set by the render graph
+	if (_offscreen && (frame.Width != _viewportWidth || frame.Height != _viewportHeight)) {
+		resizeOffscreenTarget(frame.Width, frame.Height);
+	}
+	_viewportWidth = frame.Width;
+	_viewportHeight = frame.Height;
+
+	if (frame.MaterialsChanged) {
+		updateMaterials(frame.Materials);
+	}
+
+	//Scene deltas are sent once, apply them before anything below can skip the frame.
+	//Uploads before any pass, the cull pass already reads the objects
+	if (frame.GpuScene.Enabled) {
+		GL_TRACE_SCOPE("Indirect");
+		_indirectRenderer.Apply(frame.GpuScene, _materials);
+	}
+
+	//Regrouped when the instances or the programs and textures behind their materials changed
+	if (frame.Procedural.Changed || frame.MaterialsChanged) {
+		GL_TRACE_SCOPE("Procedural");
+		_proceduralRenderer.Apply(frame.Procedural, _materials);
+	}
+
+	//Reserve the whole frame up front, the ring only waits here if the GPU still reads this region
+	auto blockSize = [this](GLsizeiptr size) { return (size + _uniformAlignment - 1) / _uniformAlignment * _uniformAlignment; };
+	auto lightBlockCount = frame.PerPacketLights ? frame.Packets.size() + 1 : 1;
+	_streamBuffer.BeginFrame(blockSize(sizeof(FrameBlock)) + lightBlockCount * blockSize(sizeof(LightBlock)) + frame.Packets.size() * blockSize(sizeof(DrawBlock)) +
+		HudRenderer::GetStreamSize(frame.Hud));
+
+	//BeginFrame may have reallocated the buffer
+	auto buffer = _streamBuffer.GetHandle();
+	const auto& sceneParams = frame.SceneParams;
+
+	auto frameData = _streamBuffer.Allocate(sizeof(FrameBlock), _uniformAlignment);
+	if (!frameData.Data) {
+		std::cerr << "RenderThread: no stream buffer space, frame skipped" << std::endl;
+		_streamBuffer.EndFrame();
+		return false;
+	}
+
+	_dynamicResolution.BeginFrame(frame.GpuBudgetMilliseconds);
+
+	FrameBlock frameBlock{
+		.Projection = sceneParams.ProjectionMatrix,
+		.View = sceneParams.ViewMatrix,
+		.EyePos = sceneParams.CameraPosition
+	};
+	std::memcpy(frameData.Data, &frameBlock, sizeof(frameBlock));
+	glBindBufferRange(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, buffer, frameData.Offset, frameData.Size);
+
+	//Shared lights, replaced per packet below when the scene has more lights than slots
+	auto sharedLightData = _streamBuffer.Allocate(sizeof(LightBlock), _uniformAlignment);
+	writeLightBlock(sharedLightData, sceneParams.DirLight, [&sceneParams](uint32_t i) {
+		return i < sceneParams.Lights.size() ? sceneParams.Lights[i] : PointLightStruct{};
+	});
+	glBindBufferRange(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, buffer, sharedLightData.Offset, sharedLightData.Size);
+
+	_drawData.resize(frame.Packets.size());
+	for (size_t i = 0; i < frame.Packets.size(); i++) {
+		const auto& packet = frame.Packets[i];
+		DrawBlock drawBlock{
+			.Model = packet.Model,
+			.PositionOffset = glm::vec4(packet.Geometry->GetPositionOffset(), 0.f),
+			.PositionScale = glm::vec4(packet.Geometry->GetPositionScale(), 0.f),
+			.MaterialIndex = packet.Material
+		};
+
+		_drawData[i] = _streamBuffer.Allocate(sizeof(DrawBlock), _uniformAlignment);
+		std::memcpy(_drawData[i].Data, &drawBlock, sizeof(drawBlock));
+	}
+
+	_renderGraph.Reset();
+	auto output = _renderGraph.ImportFramebuffer("Output", _offscreenFramebuffer, frame.Width, frame.Height);
+
+	//GPU culled objects get their draw commands from a compute pass
+	auto drawCommands = NoResource;
+	if (frame.GpuScene.Enabled && _indirectRenderer.GetObjectCount() > 0) {
+		drawCommands = _renderGraph.ImportBuffer("Draw commands");
+		_renderGraph.AddPass("GPU cull",
+			[&](RenderPassBuilder& pass) { pass.Write(drawCommands); },
+			[&](const RenderGraph&) {
+				GL_TRACE_SCOPE("GPU cull");
+				_indirectRenderer.Cull(sceneParams.ProjectionMatrix * sceneParams.ViewMatrix, _frameStats);
+			});
+	}
+
+	//Under a budget the scene renders into the corner of output sized transients and is scaled up,
+	//the HUD is drawn at full resolution after that so text doesn't get blurry with the scene
+	auto scaling = _dynamicResolution.IsScaling();
+	auto sceneSize = _dynamicResolution.GetSceneSize(frame.Width, frame.Height);
+	auto sceneColor = output;
+	auto sceneDepth = output;
+
+	auto depthPrepass = frame.DepthPrepass && !frame.Packets.empty() && _depthShader->GetHandle() != 0;
+	if (depthPrepass) {
+		_renderGraph.AddPass("Depth pre-pass",
+			[&](RenderPassBuilder& pass) {
+				if (scaling) {
+					sceneDepth = pass.CreateTexture("Scene depth", { frame.Width, frame.Height, GL_DEPTH24_STENCIL8 });
+					pass.SetRenderArea(sceneSize.x, sceneSize.y);
+				}
+				pass.WriteDepth(sceneDepth, true);
+			},
+			[&](const RenderGraph&) { drawDepthPrepass(frame); });
+	}
+
+	_renderGraph.AddPass("Scene",
+		[&](RenderPassBuilder& pass) {
+			if (scaling) {
+				sceneColor = pass.CreateTexture("Scene color", { frame.Width, frame.Height, GL_RGBA8 });
+				if (!depthPrepass) {
+					sceneDepth = pass.CreateTexture("Scene depth", { frame.Width, frame.Height, GL_DEPTH24_STENCIL8 });
+				}
+				pass.SetRenderArea(sceneSize.x, sceneSize.y);
+			}
+			pass.WriteColor(sceneColor, frame.ClearColor);
+			//Keeps the pre-pass depth
+			pass.WriteDepth(sceneDepth, !depthPrepass);
+
+			if (drawCommands != NoResource) {
+				pass.Read(drawCommands, GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+			}
+		},
+		[&](const RenderGraph&) { drawScene(frame, sharedLightData, depthPrepass); });
+
+	if (scaling) {
+		_renderGraph.AddPass("Upscale",
+			[&](RenderPassBuilder& pass) {
+				pass.Read(sceneColor);
+				pass.WriteColor(output);
+			},
+			[&](const RenderGraph& graph) {
+				GL_TRACE_SCOPE("Upscale");
+				_dynamicResolution.Upscale(graph.GetTexture(sceneColor), sceneSize, frame.UpscaleSharpness);
+			});
+	}
+
+	if (!frame.Hud.empty()) {
+		_renderGraph.AddPass("HUD",
+			[&](RenderPassBuilder& pass) { pass.WriteColor(output); },
+			[&](const RenderGraph&) {
+				GL_TRACE_SCOPE("HUD");
+				_hudRenderer.Draw(frame.Hud, frame.Width, frame.Height, _streamBuffer);
+			});
+	}
+
+	//Leaves the output bound, frame capture reads from it
+	_renderGraph.Execute(_gpuProfiler);
+
+	_dynamicResolution.EndFrame();
+	_frameStats.GpuMilliseconds = _dynamicResolution.GetGpuMilliseconds();
+	_frameStats.RenderScale = _dynamicResolution.GetScale();
+
+	_streamBuffer.EndFrame();
+	return true;
+}
+
+void RenderThread::drawDepthPrepass(const FrameSnapshot& frame) {
+	GL_TRACE_SCOPE("Depth pre-pass");
+	auto buffer = _streamBuffer.GetHandle();
+
+	//Drawing into the output writes its color attachment too, transients have none
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	_depthShader->Bind();
+	_frameStats.ProgramBinds++;
+
+	for (auto index : frame.DepthOrder) {
+		const auto& packet = frame.Packets[index];
+		glBindBufferRange(GL_UNIFORM_BUFFER, DRAW_BLOCK_BINDING, buffer, _drawData[index].Offset, _drawData[index].Size);
+
+		packet.Geometry->Draw();
+		_frameStats.DrawCalls++;
+		_frameStats.Triangles += packet.Geometry->GetElementCount() / 3;
+	}
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void RenderThread::drawScene(const FrameSnapshot& frame, const StreamAllocation& sharedLightData, bool depthPrepass) {
+	auto buffer = _streamBuffer.GetHandle();
+	const auto& sceneParams = frame.SceneParams;
+
+	{
+		PROFILE_SCOPE("Packets");
+		PROFILE_GPU_SCOPE(_gpuProfiler, "Packets");
+		GL_TRACE_SCOPE("Packets");
+
+		//Every packet's depth is in already, only the fragments that won it get shaded. LEQUAL
+		//rather than EQUAL, the invariant gl_Position makes both passes agree exactly anyway
+		if (depthPrepass) {
+			glDepthFunc(GL_LEQUAL);
+			glDepthMask(GL_FALSE);
+		}
+
+		Shader* lastBoundShader = nullptr;
+		std::array<Texture*, 2> lastBoundTextures{};
+		const LightSet* lastLightSet = nullptr;
+
+		for (const auto& packet : frame.Packets) {
+			const auto& material = _materials[packet.Material];
+			auto* shader = material.Program;
+
+			if (shader != lastBoundShader) {
+				shader->Bind();
+				lastBoundShader = shader;
+				_frameStats.ProgramBinds++;
+			}
+
+			//Block bindings outlive program changes, only write a new block when the set differs
+			if (frame.PerPacketLights && (!lastLightSet || *lastLightSet != packet.Lights)) {
+				auto lightData = _streamBuffer.Allocate(sizeof(LightBlock), _uniformAlignment);
+				writeLightBlock(lightData, sceneParams.DirLight, [&frame, &packet](uint32_t i) {
+					auto light = packet.Lights[i];
+					return light != DrawPacket::NoLight ? frame.Lights[light] : PointLightStruct{};
+				});
+				glBindBufferRange(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, buffer, lightData.Offset, lightData.Size);
+				lastLightSet = &packet.Lights;
+			}
+
+			for (uint32_t i = 0; i < material.Textures.size(); i++) {
+				if (material.Textures[i] && material.Textures[i] != lastBoundTextures[i]) {
+					glActiveTexture(GL_TEXTURE0 + i);
+					material.Textures[i]->Bind();
+					lastBoundTextures[i] = material.Textures[i];
+					_frameStats.TextureBinds++;
+				}
+			}
+
+			const auto& drawData = _drawData[&packet - frame.Packets.data()];
+			glBindBufferRange(GL_UNIFORM_BUFFER, DRAW_BLOCK_BINDING, buffer, drawData.Offset, drawData.Size);
+
+			packet.Geometry->Draw();
+			_frameStats.DrawCalls++;
+			_frameStats.Triangles += packet.Geometry->GetElementCount() / 3;
+		}
+
+		//GPU culled and procedural objects aren't in the pre-pass, they test and write depth as usual
+		if (depthPrepass) {
+			glDepthFunc(GL_LESS);
+			glDepthMask(GL_TRUE);
+		}
+	}
+
+	//GPU culled objects read their model matrix from a storage buffer and only use the shared lights
+	if (frame.GpuScene.Enabled) {
+		PROFILE_SCOPE("Indirect");
+		PROFILE_GPU_SCOPE(_gpuProfiler, "Indirect");
+		GL_TRACE_SCOPE("Indirect");
+		glBindBufferRange(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, buffer, sharedLightData.Offset, sharedLightData.Size);
+		_indirectRenderer.Draw(_frameStats);
+		glBindVertexArray(0);
+	}
+
+	if (_proceduralRenderer.GetInstanceCount() > 0) {
+		PROFILE_SCOPE("Procedural");
+		PROFILE_GPU_SCOPE(_gpuProfiler, "Procedural");
+		GL_TRACE_SCOPE("Procedural");
+		glBindBufferRange(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, buffer, sharedLightData.Offset, sharedLightData.Size);
+		_proceduralRenderer.Draw(_frameStats);
+	}
+}
+
+void RenderThread::updateMaterials(const std::vector<Material>& materials) {
+	GL_TRACE_SCOPE("Materials");
+	_materials = materials;
+
+	std::vector<MaterialBlock> blocks;
+	blocks.reserve(materials.size());
+	for (const auto& material : materials) {
+		blocks.push_back(ToBlock(material));
+	}
+
+	//Materials change rarely, respecifying the whole buffer is fine
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, _materialBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, blocks.size() * sizeof(MaterialBlock), blocks.data(), GL_STATIC_DRAW);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _materialBuffer, blocks.size() * sizeof(MaterialBlock));
+}
+
+void RenderThread::resizeOffscreenTarget(int width, int height) {
+	releaseOffscreenTarget();
+
+	//Renderbuffers, the frames are only rendered and never sampled or read back
+	glGenRenderbuffers(1, &_offscreenColor);
+	glBindRenderbuffer(GL_RENDERBUFFER, _offscreenColor);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	GpuMemory::Track(GpuMemory::Kind::Renderbuffer, _offscreenColor, static_cast<int64_t>(width) * height * 4);
+
+	glGenRenderbuffers(1, &_offscreenDepth);
+	glBindRenderbuffer(GL_RENDERBUFFER, _offscreenDepth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	GpuMemory::Track(GpuMemory::Kind::Renderbuffer, _offscreenDepth, static_cast<int64_t>(width) * height * 4);
+
+	glGenFramebuffers(1, &_offscreenFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, _offscreenFramebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _offscreenColor);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _offscreenDepth);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		std::cerr << "RenderThread: offscreen framebuffer " << width << "x" << height << " incomplete" << std::endl;
+	}
+}
+
+void RenderThread::releaseOffscreenTarget() {
+	if (!_offscreenFramebuffer) {
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteFramebuffers(1, &_offscreenFramebuffer);
+
+	GpuMemory::Forget(GpuMemory::Kind::Renderbuffer, _offscreenColor);
+	GpuMemory::Forget(GpuMemory::Kind::Renderbuffer, _offscreenDepth);
+	glDeleteRenderbuffers(1, &_offscreenColor);
+	glDeleteRenderbuffers(1, &_offscreenDepth);
+
+	_offscreenFramebuffer = 0;
+	_offscreenColor = 0;
+	_offscreenDepth = 0;
+}
@@ -0,0 +1,129 @@
+#include <rendering/stream_buffer.h>
+#include <rendering/gpu_memory.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+StreamBuffer::~StreamBuffer() {
+	Release();
+}
+
+bool StreamBuffer::Init(GLsizeiptr regionSize) {
+	Release();
+
+	constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	auto totalSize = regionSize * RegionCount;
+
+	//Immutable storage, the mapping stays valid while the GPU reads from it
+	glGenBuffers(1, &_buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+	GpuMemory::Track(GpuMemory::Kind::Buffer, _buffer, totalSize);
+	_mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags));
+
+	if (!_mapped) {
+		std::cerr << "StreamBuffer: failed to map " << totalSize << " bytes persistently" << std::endl;
+		Release();
+		return false;
+	}
+
+	_regionSize = regionSize;
+	_region = 0;
+	_head = 0;
+	return true;
+}
+
+void StreamBuffer::BeginFrame(GLsizeiptr requiredSize) {
+	if (requiredSize > _regionSize) {
+		//The old storage may still be read by frames in flight
+		for (uint32_t region = 0; region < RegionCount; region++) {
+			waitForRegion(region);
+		}
+
+		auto regionSize = std::max(requiredSize, _regionSize * 2);
+		if (Init(regionSize)) {
+			_stats.Reallocations++;
+		}
+		return;
+	}
+
+	_region = (_region + 1) % RegionCount;
+	_head = 0;
+	_stats.BytesLastFrame = 0;
+	waitForRegion(_region);
+}
+
+StreamAllocation StreamBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment) {
+	auto offset = (_head + alignment - 1) / alignment * alignment;
+	if (!_mapped || offset + size > _regionSize) {
+		return {};
+	}
+
+	_head = offset + size;
+	_stats.BytesLastFrame = _head;
+
+	auto bufferOffset = static_cast<GLintptr>(_region) * _regionSize + offset;
+	return { _mapped + bufferOffset, bufferOffset, size };
+}
+
+void StreamBuffer::EndFrame() {
+	if (!_mapped) {
+		return;
+	}
+
+	_fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::waitForRegion(uint32_t region) {
+	auto fence = _fences[region];
+	if (!fence) {
+		return;
+	}
+
+	//Already signaled is the common case and costs no wait
+	auto result = glClientWaitSync(fence, 0, 0);
+	if (result == GL_TIMEOUT_EXPIRED) {
+		auto start = std::chrono::steady_clock::now();
+
+		//Flush once so the fence can signal at all, then wait in one second steps
+		GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		do {
+			result = glClientWaitSync(fence, waitFlags, 1'000'000'000);
+			waitFlags = 0;
+		} while (result == GL_TIMEOUT_EXPIRED);
+
+		auto waited = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		_stats.Waits++;
+		_stats.WaitMilliseconds += waited;
+		_stats.LastWaitMilliseconds = waited;
+	}
+
+	if (result == GL_WAIT_FAILED) {
+		std::cerr << "StreamBuffer: waiting for region " << region << " failed" << std::endl;
+	}
+
+	glDeleteSync(fence);
+	_fences[region] = nullptr;
+}
+
+void StreamBuffer::Release() {
+	for (auto& fence : _fences) {
+		if (fence) {
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+
+	if (_buffer) {
+		if (_mapped) {
+			glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer);
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		}
+		GpuMemory::Forget(GpuMemory::Kind::Buffer, _buffer);
+		glDeleteBuffers(1, &_buffer);
+	}
+
+	_buffer = 0;
+	_mapped = nullptr;
+	_regionSize = 0;
+}